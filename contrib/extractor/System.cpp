@@ -310,6 +310,23 @@ struct map_liquidHeader
     float  liquidLevel;
 };
 
+// the server maps .map files and reads the arrays in place, every section starts aligned
+#define MAP_SECTION_ALIGNMENT 4
+
+uint32 AlignMapOffset(uint32 offset)
+{
+    return (offset + MAP_SECTION_ALIGNMENT - 1) & ~uint32(MAP_SECTION_ALIGNMENT - 1);
+}
+
+void WriteMapPadding(FILE* output, uint32 offset)
+{
+    static uint8 const zero[MAP_SECTION_ALIGNMENT] = { 0 };
+
+    long position = ftell(output);
+    if (position >= 0 && uint32(position) < offset)
+        fwrite(zero, 1, offset - uint32(position), output);
+}
+
 float selectUInt8StepStore(float maxDiff)
 {
     return 255 / maxDiff;
@@ -765,7 +782,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
                     liquid_height[y][x] = CONF_use_minHeight;
             }
         }
-        map.liquidMapOffset = map.heightMapOffset + map.heightMapSize;
+        map.liquidMapOffset = AlignMapOffset(map.heightMapOffset + map.heightMapSize);
         map.liquidMapSize = sizeof(map_liquidHeader);
         liquidHeader.fourcc = *(uint32 const*)MAP_LIQUID_MAGIC;
         liquidHeader.flags = 0;
@@ -799,9 +816,9 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
     uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
     if (map.liquidMapOffset)
-        map.holesOffset = map.liquidMapOffset + map.liquidMapSize;
+        map.holesOffset = AlignMapOffset(map.liquidMapOffset + map.liquidMapSize);
     else
-        map.holesOffset = map.heightMapOffset + map.heightMapSize;
+        map.holesOffset = AlignMapOffset(map.heightMapOffset + map.heightMapSize);
 
     map.holesSize = sizeof(holes);
     memset(holes, 0, map.holesSize);
@@ -854,6 +871,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
     // Store liquid data if need
     if (map.liquidMapOffset)
     {
+        WriteMapPadding(output, map.liquidMapOffset);
         fwrite(&liquidHeader, sizeof(liquidHeader), 1, output);
         if (!(liquidHeader.flags & MAP_LIQUID_NO_TYPE))
         {
@@ -868,6 +886,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
     }
 
     // store hole data
+    WriteMapPadding(output, map.holesOffset);
     fwrite(holes, map.holesSize, 1, output);
 
     fclose(output);
@@ -25,7 +25,9 @@
 #include "DetourNavMeshBuilder.h"
 #include "DetourCommon.h"
 
+#include <algorithm>
 #include <climits>
+#include <thread>
 
 using namespace VMAP;
 
@@ -33,20 +35,20 @@ namespace MMAP
 {
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
                            bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
-        m_terrainBuilder(NULL),
+                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath, uint32 threads) :
         m_debugOutput(debugOutput),
         m_skipContinents(skipContinents),
         m_skipJunkMaps(skipJunkMaps),
         m_skipBattlegrounds(skipBattlegrounds),
         m_maxWalkableAngle(maxWalkableAngle),
         m_bigBaseUnit(bigBaseUnit),
-        m_rcContext(NULL),
-        m_offMeshFilePath(offMeshFilePath)
+        m_threads(threads ? threads : 1),
+        m_context(NULL),
+        m_offMeshFilePath(offMeshFilePath),
+        m_nextJob(0),
+        m_doneJobs(0)
     {
-        m_terrainBuilder = new TerrainBuilder(skipLiquid);
-
-        m_rcContext = new rcContext(false);
+        m_context = new TileBuildContext(skipLiquid);
 
         discoverTiles();
     }
@@ -60,8 +62,7 @@ namespace MMAP
             delete (*it).second;
         }
 
-        delete m_terrainBuilder;
-        delete m_rcContext;
+        delete m_context;
     }
 
     /**************************************************************************/
@@ -144,12 +145,15 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildAllMaps()
     {
+        std::vector<uint32> mapIDs;
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapID = (*it).first;
             if (!shouldSkipMap(mapID))
-                buildMap(mapID);
+                mapIDs.push_back(mapID);
         }
+
+        buildMaps(mapIDs);
     }
 
     /**************************************************************************/
@@ -168,7 +172,7 @@ namespace MMAP
 
         // make sure we process maps which don't have tiles
         // initialize the static tree, which loads WDT models
-        if (!m_terrainBuilder->loadVMap(mapID, 64, 64, meshData))
+        if (!m_context->terrainBuilder.loadVMap(mapID, 64, 64, meshData))
             return;
 
         // get the coord bounds of the model data
@@ -198,89 +202,195 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildSingleTile(uint32 mapID, uint32 tileX, uint32 tileY)
     {
-        dtNavMesh* navMesh = NULL;
-        buildNavMesh(mapID, navMesh);
-        if (!navMesh)
+        MapBuildState map(mapID);
+        buildNavMesh(mapID, map.navMesh);
+        if (!map.navMesh)
         {
             printf("[Map %03i] Failed creating navmesh!                   \n", mapID);
             return;
         }
 
-        buildTile(mapID, tileX, tileY, navMesh, 1, 1);
-        dtFreeNavMesh(navMesh);
+        printf("[Map %03i] Building tile [%02u,%02u]                     \n", mapID, tileX, tileY);
+
+        TileBuildResult result = buildTile(*m_context, map, tileX, tileY);
+        if (result != TILE_BUILD_FAILED)
+            recordTile(mapID, tileX, tileY, result);
+
+        dtFreeNavMesh(map.navMesh);
     }
 
     /**************************************************************************/
     void MapBuilder::buildMap(uint32 mapID)
     {
-        printf("Building map %03u:                                    \n", mapID);
+        std::vector<uint32> mapIDs(1, mapID);
+        buildMaps(mapIDs);
+    }
 
-        std::set<uint32>* tiles = getTileList(mapID);
+    /**************************************************************************/
+    void MapBuilder::buildMaps(std::vector<uint32> const& mapIDs)
+    {
+        loadManifest();
 
-        // make sure we process maps which don't have tiles
-        if (!tiles->size())
+        std::vector<MapBuildState*> maps;
+        m_jobs.clear();
+
+        for (std::vector<uint32>::const_iterator mapItr = mapIDs.begin(); mapItr != mapIDs.end(); ++mapItr)
         {
-            // convert coord bounds to grid bounds
-            uint32 minX, minY, maxX, maxY;
-            getGridBounds(mapID, minX, minY, maxX, maxY);
-
-            // add all tiles within bounds to tile list.
-            for (uint32 i = minX; i <= maxX; ++i)
-                for (uint32 j = minY; j <= maxY; ++j)
-                    tiles->insert(StaticMapTree::packTileID(i, j));
+            uint32 mapID = *mapItr;
+            printf("Building map %03u:                                    \n", mapID);
+
+            std::set<uint32>* tiles = getTileList(mapID);
+
+            // make sure we process maps which don't have tiles
+            if (!tiles->size())
+            {
+                // convert coord bounds to grid bounds
+                uint32 minX, minY, maxX, maxY;
+                getGridBounds(mapID, minX, minY, maxX, maxY);
+
+                // add all tiles within bounds to tile list.
+                for (uint32 i = minX; i <= maxX; ++i)
+                    for (uint32 j = minY; j <= maxY; ++j)
+                        tiles->insert(StaticMapTree::packTileID(i, j));
+            }
+
+            if (!tiles->size())
+                continue;
+
+            // build navMesh
+            MapBuildState* map = new MapBuildState(mapID);
+            buildNavMesh(mapID, map->navMesh);
+            if (!map->navMesh)
+            {
+                printf("[Map %03i] Failed creating navmesh!                   \n", mapID);
+                delete map;
+                continue;
+            }
+
+            for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
+            {
+                TileBuildJob job;
+                job.map = map;
+
+                // unpack tile coords
+                StaticMapTree::unpackTileID((*it), job.tileX, job.tileY);
+
+                if (isTileBuilt(mapID, job.tileX, job.tileY))
+                    continue;
+
+                m_jobs.push_back(job);
+                ++map->tileCount;
+            }
+
+            printf("[Map %03i] We have %u tiles, %u to build.             \n", mapID, uint32(tiles->size()), map->tileCount);
+
+            if (!map->tileCount)
+            {
+                printf("[Map %03i] Complete!                             \n\n", mapID);
+                dtFreeNavMesh(map->navMesh);
+                delete map;
+                continue;
+            }
+
+            map->remaining = map->tileCount;
+            maps.push_back(map);
         }
 
-        if (!tiles->size())
-            return;
+        // tiles of all maps go through one queue, a thread done with a small map continues with the next one
+        uint32 threads = std::min(m_threads, uint32(m_jobs.size()));
+        if (threads > 1)
+            printf("Building %u tiles on %u threads\n\n", uint32(m_jobs.size()), threads);
 
-        // build navMesh
-        dtNavMesh* navMesh = NULL;
-        buildNavMesh(mapID, navMesh);
-        if (!navMesh)
+        m_nextJob = 0;
+        m_doneJobs = 0;
+        m_startTime = std::chrono::steady_clock::now();
+
+        if (threads > 1)
         {
-            printf("[Map %03i] Failed creating navmesh!                   \n", mapID);
-            return;
+            std::vector<TileBuildContext*> contexts;
+            std::vector<std::thread> workers;
+            for (uint32 i = 0; i < threads; ++i)
+            {
+                contexts.push_back(new TileBuildContext(!m_context->terrainBuilder.usesLiquids()));
+                workers.push_back(std::thread(&MapBuilder::buildTilesWorker, this, contexts.back()));
+            }
+
+            for (uint32 i = 0; i < threads; ++i)
+            {
+                workers[i].join();
+                delete contexts[i];
+            }
         }
+        else
+            buildTilesWorker(m_context);
 
-        // now start building mmtiles for each tile
-        printf("[Map %03i] We have %u tiles.                          \n", mapID, uint32(tiles->size()));
+        if (m_doneJobs)
+        {
+            double minutes = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count() / 60.0;
+            printf("Built %u tiles in %.1f minutes (%.1f tiles/min)\n", uint32(m_doneJobs), minutes, minutes > 0.0 ? m_doneJobs / minutes : 0.0);
+        }
 
-        uint32 currentTile = 0;
-        for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
+        for (std::vector<MapBuildState*>::iterator itr = maps.begin(); itr != maps.end(); ++itr)
+            delete *itr;
+
+        m_jobs.clear();
+    }
+
+    /**************************************************************************/
+    void MapBuilder::buildTilesWorker(TileBuildContext* context)
+    {
+        while (true)
         {
-            currentTile++;
-            uint32 tileX, tileY;
+            uint32 index = m_nextJob++;
+            if (index >= m_jobs.size())
+                break;
 
-            // unpack tile coords
-            StaticMapTree::unpackTileID((*it), tileX, tileY);
+            TileBuildJob& job = m_jobs[index];
+            MapBuildState& map = *job.map;
 
-            if (shouldSkipTile(mapID, tileX, tileY))
-                continue;
+            TileBuildResult result = buildTile(*context, map, job.tileX, job.tileY);
+            uint32 done = ++m_doneJobs;
 
-            buildTile(mapID, tileX, tileY, navMesh, currentTile, uint32(tiles->size()));
-        }
+            double minutes = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count() / 60.0;
+
+            {
+                std::lock_guard<std::mutex> guard(m_outputLock);
+
+                if (result != TILE_BUILD_FAILED)
+                    recordTile(map.mapID, job.tileX, job.tileY, result);
 
-        dtFreeNavMesh(navMesh);
+                printf("[Map %03i] Tile [%02u,%02u] %s (%u / %u, %.1f tiles/min)      \n", map.mapID, job.tileX, job.tileY,
+                       result == TILE_BUILD_FAILED ? "failed" : "done", done, uint32(m_jobs.size()), minutes > 0.0 ? done / minutes : 0.0);
+            }
+
+            // the last tile of the map, no other thread uses its navmesh anymore
+            if (--map.remaining == 0)
+            {
+                dtFreeNavMesh(map.navMesh);
+                map.navMesh = NULL;
 
-        printf("[Map %03i] Complete!                             \n\n", mapID);
+                std::lock_guard<std::mutex> guard(m_outputLock);
+                printf("[Map %03i] Complete!                             \n\n", map.mapID);
+            }
+        }
     }
 
     /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint32 curTile, uint32 tileCount)
+    TileBuildResult MapBuilder::buildTile(TileBuildContext& context, MapBuildState& map, uint32 tileX, uint32 tileY)
     {
-        printf("[Map %03i] Building tile [%02u,%02u] (%02u / %02u)    \n", mapID, tileX, tileY, curTile, tileCount);
+        uint32 mapID = map.mapID;
 
         MeshData meshData;
 
         // get heightmap data
-        m_terrainBuilder->loadMap(mapID, tileX, tileY, meshData);
+        context.terrainBuilder.loadMap(mapID, tileX, tileY, meshData);
 
         // get model data
-        m_terrainBuilder->loadVMap(mapID, tileY, tileX, meshData);
+        context.terrainBuilder.loadVMap(mapID, tileY, tileX, meshData);
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
-            return;
+            return TILE_BUILD_EMPTY;
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
@@ -292,16 +402,16 @@ namespace MMAP
         allVerts.append(meshData.solidVerts);
 
         if (!allVerts.size())
-            return;
+            return TILE_BUILD_EMPTY;
 
         // get bounds of current tile
         float bmin[3], bmax[3];
         getTileBounds(tileX, tileY, allVerts.getCArray(), allVerts.size() / 3, bmin, bmax);
 
-        m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
+        context.terrainBuilder.loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        return buildMoveMapTile(context, map, tileX, tileY, meshData, bmin, bmax);
     }
 
     /**************************************************************************/
@@ -380,10 +490,13 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
-                                      MeshData& meshData, float bmin[3], float bmax[3],
-                                      dtNavMesh* navMesh)
+    TileBuildResult MapBuilder::buildMoveMapTile(TileBuildContext& context, MapBuildState& map,
+                                                 uint32 tileX, uint32 tileY,
+                                                 MeshData& meshData, float bmin[3], float bmax[3])
     {
+        uint32 mapID = map.mapID;
+        rcContext* rcCtx = &context.recast;
+
         // console output
         char tileString[20];
         sprintf(tileString, "[Map %03i] [%02i,%02i]: ", mapID, tileX, tileY);
@@ -468,7 +581,7 @@ namespace MMAP
 
                 // build heightfield
                 tile.solid = rcAllocHeightfield();
-                if (!tile.solid || !rcCreateHeightfield(m_rcContext, *tile.solid, tileCfg.width, tileCfg.height, tileCfg.bmin, tileCfg.bmax, tileCfg.cs, tileCfg.ch))
+                if (!tile.solid || !rcCreateHeightfield(rcCtx, *tile.solid, tileCfg.width, tileCfg.height, tileCfg.bmin, tileCfg.bmax, tileCfg.cs, tileCfg.ch))
                 {
                     printf("%s Failed building heightfield!                       \n", tileString);
                     continue;
@@ -477,45 +590,45 @@ namespace MMAP
                 // mark all walkable tiles, both liquids and solids
                 unsigned char* triFlags = new unsigned char[tTriCount];
                 memset(triFlags, NAV_GROUND, tTriCount * sizeof(unsigned char));
-                rcClearUnwalkableTriangles(m_rcContext, tileCfg.walkableSlopeAngle, tVerts, tVertCount, tTris, tTriCount, triFlags);
-                rcRasterizeTriangles(m_rcContext, tVerts, tVertCount, tTris, triFlags, tTriCount, *tile.solid, config.walkableClimb);
+                rcClearUnwalkableTriangles(rcCtx, tileCfg.walkableSlopeAngle, tVerts, tVertCount, tTris, tTriCount, triFlags);
+                rcRasterizeTriangles(rcCtx, tVerts, tVertCount, tTris, triFlags, tTriCount, *tile.solid, config.walkableClimb);
                 delete [] triFlags;
 
-                rcFilterLowHangingWalkableObstacles(m_rcContext, config.walkableClimb, *tile.solid);
-                rcFilterLedgeSpans(m_rcContext, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid);
-                rcFilterWalkableLowHeightSpans(m_rcContext, tileCfg.walkableHeight, *tile.solid);
+                rcFilterLowHangingWalkableObstacles(rcCtx, config.walkableClimb, *tile.solid);
+                rcFilterLedgeSpans(rcCtx, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid);
+                rcFilterWalkableLowHeightSpans(rcCtx, tileCfg.walkableHeight, *tile.solid);
 
-                rcRasterizeTriangles(m_rcContext, lVerts, lVertCount, lTris, lTriFlags, lTriCount, *tile.solid, config.walkableClimb);
+                rcRasterizeTriangles(rcCtx, lVerts, lVertCount, lTris, lTriFlags, lTriCount, *tile.solid, config.walkableClimb);
 
                 // compact heightfield spans
                 tile.chf = rcAllocCompactHeightfield();
-                if (!tile.chf || !rcBuildCompactHeightfield(m_rcContext, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid, *tile.chf))
+                if (!tile.chf || !rcBuildCompactHeightfield(rcCtx, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid, *tile.chf))
                 {
                     printf("%s Failed compacting heightfield!                     \n", tileString);
                     continue;
                 }
 
                 // build polymesh intermediates
-                if (!rcErodeWalkableArea(m_rcContext, config.walkableRadius, *tile.chf))
+                if (!rcErodeWalkableArea(rcCtx, config.walkableRadius, *tile.chf))
                 {
                     printf("%s Failed eroding area!                               \n", tileString);
                     continue;
                 }
 
-                if (!rcBuildDistanceField(m_rcContext, *tile.chf))
+                if (!rcBuildDistanceField(rcCtx, *tile.chf))
                 {
                     printf("%s Failed building distance field!                    \n", tileString);
                     continue;
                 }
 
-                if (!rcBuildRegions(m_rcContext, *tile.chf, tileCfg.borderSize, tileCfg.minRegionArea, tileCfg.mergeRegionArea))
+                if (!rcBuildRegions(rcCtx, *tile.chf, tileCfg.borderSize, tileCfg.minRegionArea, tileCfg.mergeRegionArea))
                 {
                     printf("%s Failed building regions!                           \n", tileString);
                     continue;
                 }
 
                 tile.cset = rcAllocContourSet();
-                if (!tile.cset || !rcBuildContours(m_rcContext, *tile.chf, tileCfg.maxSimplificationError, tileCfg.maxEdgeLen, *tile.cset))
+                if (!tile.cset || !rcBuildContours(rcCtx, *tile.chf, tileCfg.maxSimplificationError, tileCfg.maxEdgeLen, *tile.cset))
                 {
                     printf("%s Failed building contours!                          \n", tileString);
                     continue;
@@ -523,14 +636,14 @@ namespace MMAP
 
                 // build polymesh
                 tile.pmesh = rcAllocPolyMesh();
-                if (!tile.pmesh || !rcBuildPolyMesh(m_rcContext, *tile.cset, tileCfg.maxVertsPerPoly, *tile.pmesh))
+                if (!tile.pmesh || !rcBuildPolyMesh(rcCtx, *tile.cset, tileCfg.maxVertsPerPoly, *tile.pmesh))
                 {
                     printf("%s Failed building polymesh!                          \n", tileString);
                     continue;
                 }
 
                 tile.dmesh = rcAllocPolyMeshDetail();
-                if (!tile.dmesh || !rcBuildPolyMeshDetail(m_rcContext, *tile.pmesh, *tile.chf, tileCfg.detailSampleDist, tileCfg    .detailSampleMaxError, *tile.dmesh))
+                if (!tile.dmesh || !rcBuildPolyMeshDetail(rcCtx, *tile.pmesh, *tile.chf, tileCfg.detailSampleDist, tileCfg    .detailSampleMaxError, *tile.dmesh))
                 {
                     printf("%s Failed building polymesh detail!                   \n", tileString);
                     continue;
@@ -574,9 +687,9 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return TILE_BUILD_FAILED;
         }
-        rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
+        rcMergePolyMeshes(rcCtx, pmmerge, nmerge, *iv.polyMesh);
 
         iv.polyMeshDetail = rcAllocPolyMeshDetail();
         if (!iv.polyMeshDetail)
@@ -585,9 +698,9 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return TILE_BUILD_FAILED;
         }
-        rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
+        rcMergePolyMeshDetails(rcCtx, dmmerge, nmerge, *iv.polyMeshDetail);
 
         // free things up
         delete [] pmmerge;
@@ -627,8 +740,8 @@ namespace MMAP
         params.walkableHeight = BASE_UNIT_DIM * config.walkableHeight;  // agent height
         params.walkableRadius = BASE_UNIT_DIM * config.walkableRadius;  // agent radius
         params.walkableClimb = BASE_UNIT_DIM * config.walkableClimb;    // keep less that walkableHeight (aka agent height)!
-        params.tileX = (((bmin[0] + bmax[0]) / 2) - navMesh->getParams()->orig[0]) / GRID_SIZE;
-        params.tileY = (((bmin[2] + bmax[2]) / 2) - navMesh->getParams()->orig[2]) / GRID_SIZE;
+        params.tileX = (((bmin[0] + bmax[0]) / 2) - map.navMesh->getParams()->orig[0]) / GRID_SIZE;
+        params.tileY = (((bmin[2] + bmax[2]) / 2) - map.navMesh->getParams()->orig[2]) / GRID_SIZE;
         rcVcopy(params.bmin, bmin);
         rcVcopy(params.bmax, bmax);
         params.cs = config.cs;
@@ -640,6 +753,8 @@ namespace MMAP
         unsigned char* navData = NULL;
         int navDataSize = 0;
 
+        TileBuildResult result = TILE_BUILD_FAILED;
+
         do
         {
             // these values are checked within dtCreateNavMeshData - handle them here
@@ -661,6 +776,7 @@ namespace MMAP
 
                 // message is an annoyance
                 //printf("%sNo vertices to build tile!              \n", tileString);
+                result = TILE_BUILD_EMPTY;
                 continue;
             }
             if (!params.polyCount || !params.polys ||
@@ -670,6 +786,7 @@ namespace MMAP
                 // keep in mind that we do output those into debug info
                 // drop tiles with only exact count - some tiles may have geometry while having less tiles
                 printf("%s No polygons to build on tile!                      \n", tileString);
+                result = TILE_BUILD_EMPTY;
                 continue;
             }
             if (!params.detailMeshes || !params.detailVerts || !params.detailTris)
@@ -685,44 +802,62 @@ namespace MMAP
                 continue;
             }
 
+            // the tile data does not depend on the navmesh, adding it only validates it
+            // so the output is the same whatever order the threads finish their tiles in
             dtTileRef tileRef = 0;
             printf("%s Adding tile to navmesh...                          \r", tileString);
-            // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
-            // is removed via removeTile()
-            dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
-            if (!tileRef || dtStatusFailed(dtResult))
             {
-                printf("%s Failed adding tile to navmesh!                     \n", tileString);
-                continue;
+                std::lock_guard<std::mutex> guard(map.navMeshLock);
+                // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
+                // is removed via removeTile()
+                dtStatus dtResult = map.navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
+                if (!tileRef || dtStatusFailed(dtResult))
+                {
+                    printf("%s Failed adding tile to navmesh!                     \n", tileString);
+                    dtFree(navData);
+                    continue;
+                }
             }
 
-            // file output
+            // file output, written aside and renamed so an interrupted run never leaves a truncated tile
+            // that shouldSkipTile would take for a complete one
             char fileName[255];
+            char tempFileName[255];
             sprintf(fileName, "mmaps/%03u%02i%02i.mmtile", mapID, tileY, tileX);
-            FILE* file = fopen(fileName, "wb");
-            if (!file)
+            sprintf(tempFileName, "%s.tmp", fileName);
+            FILE* file = fopen(tempFileName, "wb");
+            if (file)
+            {
+                printf("%s Writing to file...                                 \r", tileString);
+
+                // write header
+                MmapTileHeader header;
+                header.size = uint32(navDataSize);
+                header.usesLiquids = context.terrainBuilder.usesLiquids() ? 1 : 0;
+                bool written = fwrite(&header, sizeof(MmapTileHeader), 1, file) == 1;
+
+                // write data
+                written = fwrite(navData, sizeof(unsigned char), navDataSize, file) == size_t(navDataSize) && written;
+                written = fclose(file) == 0 && written;
+
+                // rename does not replace existing files on all platforms
+                remove(fileName);
+                if (written && rename(tempFileName, fileName) == 0)
+                    result = TILE_BUILD_WRITTEN;
+                else
+                    remove(tempFileName);
+            }
+
+            if (result != TILE_BUILD_WRITTEN)
             {
                 char message[1024];
-                sprintf(message, "[Map %03i] Failed to open %s for writing!             \n", mapID, fileName);
+                sprintf(message, "[Map %03i] Failed to write %s!             \n", mapID, fileName);
                 perror(message);
-                navMesh->removeTile(tileRef, NULL, NULL);
-                continue;
             }
 
-            printf("%s Writing to file...                                 \r", tileString);
-
-            // write header
-            MmapTileHeader header;
-            header.size = uint32(navDataSize);
-            header.usesLiquids = m_terrainBuilder->usesLiquids() ? 1 : 0;
-            fwrite(&header, sizeof(MmapTileHeader), 1, file);
-
-            // write data
-            fwrite(navData, sizeof(unsigned char), navDataSize, file);
-            fclose(file);
-
             // now that tile is written to disk, we can unload it
-            navMesh->removeTile(tileRef, NULL, NULL);
+            std::lock_guard<std::mutex> guard(map.navMeshLock);
+            map.navMesh->removeTile(tileRef, NULL, NULL);
         }
         while (0);
 
@@ -739,6 +874,8 @@ namespace MMAP
             iv.generateObjFile(mapID, tileX, tileY, meshData);
             iv.writeIV(mapID, tileX, tileY);
         }
+
+        return result;
     }
 
     /**************************************************************************/
@@ -851,4 +988,48 @@ namespace MMAP
         return true;
     }
 
+    /**************************************************************************/
+    void MapBuilder::loadManifest()
+    {
+        m_manifest.clear();
+
+        FILE* file = fopen("mmaps/manifest.txt", "r");
+        if (!file)
+            return;
+
+        uint32 mapID, tileX, tileY, written;
+        while (fscanf(file, "%u %u %u %u", &mapID, &tileX, &tileY, &written) == 4)
+            m_manifest[uint64(mapID) << 32 | StaticMapTree::packTileID(tileX, tileY)] = written != 0;
+
+        fclose(file);
+
+        if (!m_manifest.empty())
+            printf("Resuming, %u tiles are listed in mmaps/manifest.txt\n", uint32(m_manifest.size()));
+    }
+
+    /**************************************************************************/
+    void MapBuilder::recordTile(uint32 mapID, uint32 tileX, uint32 tileY, TileBuildResult result)
+    {
+        m_manifest[uint64(mapID) << 32 | StaticMapTree::packTileID(tileX, tileY)] = result == TILE_BUILD_WRITTEN;
+
+        // several generators may share the mmaps directory, append one short line at once
+        FILE* file = fopen("mmaps/manifest.txt", "a");
+        if (!file)
+            return;
+
+        fprintf(file, "%03u %02u %02u %u\n", mapID, tileX, tileY, result == TILE_BUILD_WRITTEN ? 1 : 0);
+        fclose(file);
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::isTileBuilt(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        // written tiles are checked on disk, they may have been removed to be built again
+        if (shouldSkipTile(mapID, tileX, tileY))
+            return true;
+
+        std::map<uint64, bool>::const_iterator itr = m_manifest.find(uint64(mapID) << 32 | StaticMapTree::packTileID(tileX, tileY));
+        return itr != m_manifest.end() && !itr->second;
+    }
+
 }
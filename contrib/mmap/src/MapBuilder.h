@@ -22,6 +22,9 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
 #include "TerrainBuilder.h"
 #include "IntermediateValues.h"
@@ -57,6 +60,40 @@ namespace MMAP
         rcPolyMeshDetail* dmesh;
     };
 
+    enum TileBuildResult
+    {
+        TILE_BUILD_EMPTY,                                   // no geometry, nothing written
+        TILE_BUILD_WRITTEN,
+        TILE_BUILD_FAILED                                   // not recorded in the manifest, built again by the next run
+    };
+
+    // everything a tile build writes to, one per worker thread
+    struct TileBuildContext
+    {
+        TileBuildContext(bool skipLiquid) : terrainBuilder(skipLiquid), recast(false) {}
+
+        TerrainBuilder terrainBuilder;
+        rcContext recast;
+    };
+
+    struct MapBuildState
+    {
+        MapBuildState(uint32 id) : mapID(id), navMesh(NULL), tileCount(0), remaining(0) {}
+
+        uint32 mapID;
+        dtNavMesh* navMesh;                                 // only used to validate tiles, add/remove under navMeshLock
+        std::mutex navMeshLock;
+        uint32 tileCount;
+        std::atomic<uint32> remaining;
+    };
+
+    struct TileBuildJob
+    {
+        MapBuildState* map;
+        uint32 tileX;
+        uint32 tileY;
+    };
+
     class MapBuilder
     {
         public:
@@ -67,7 +104,8 @@ namespace MMAP
                        bool skipBattlegrounds   = false,
                        bool debugOutput         = false,
                        bool bigBaseUnit         = false,
-                       const char* offMeshFilePath = NULL);
+                       const char* offMeshFilePath = NULL,
+                       uint32 threads           = 1);
 
             ~MapBuilder();
 
@@ -85,18 +123,27 @@ namespace MMAP
             void discoverTiles();
             std::set<uint32>* getTileList(uint32 mapID);
 
+            // builds the tiles of all given maps from one queue shared by all worker threads
+            void buildMaps(std::vector<uint32> const& mapIDs);
+            void buildTilesWorker(TileBuildContext* context);
+
             void buildNavMesh(uint32 mapID, dtNavMesh*& navMesh);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint32 curTile, uint32 tileCount);
+            TileBuildResult buildTile(TileBuildContext& context, MapBuildState& map, uint32 tileX, uint32 tileY);
 
             // move map building
-            void buildMoveMapTile(uint32 mapID,
-                                  uint32 tileX,
-                                  uint32 tileY,
-                                  MeshData& meshData,
-                                  float bmin[3],
-                                  float bmax[3],
-                                  dtNavMesh* navMesh);
+            TileBuildResult buildMoveMapTile(TileBuildContext& context,
+                                             MapBuildState& map,
+                                             uint32 tileX,
+                                             uint32 tileY,
+                                             MeshData& meshData,
+                                             float bmin[3],
+                                             float bmax[3]);
+
+            // resume support, every finished tile is appended to mmaps/manifest.txt
+            void loadManifest();
+            void recordTile(uint32 mapID, uint32 tileX, uint32 tileY, TileBuildResult result);
+            bool isTileBuilt(uint32 mapID, uint32 tileX, uint32 tileY);
 
             void getTileBounds(uint32 tileX, uint32 tileY,
                                float* verts, int vertCount,
@@ -120,8 +167,19 @@ namespace MMAP
             float m_maxWalkableAngle;
             bool m_bigBaseUnit;
 
-            // build performance - not really used for now
-            rcContext* m_rcContext;
+            uint32 m_threads;
+
+            // used by the calling thread, the workers of buildMaps have their own
+            TileBuildContext* m_context;
+
+            std::map<uint64, bool> m_manifest;              // (mapID << 32 | tileID) -> tile file written
+
+            // current buildMaps run
+            std::vector<TileBuildJob> m_jobs;
+            std::atomic<uint32> m_nextJob;
+            std::atomic<uint32> m_doneJobs;
+            std::chrono::steady_clock::time_point m_startTime;
+            std::mutex m_outputLock;                        // progress lines and manifest appends
     };
 }
 
@@ -18,24 +18,31 @@
 
 #include <string>
 #include <iostream>
+#include <cstdlib>
+#include <thread>
 
 #include "TileAssembler.h"
 
 //=======================================================
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
+    if (argc != 3 && argc != 4)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [threads]" << std::endl;
         return 1;
     }
 
     std::string src = argv[1];
     std::string dest = argv[2];
 
-    std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
+    // maps and model files are converted on all cores by default
+    unsigned int threads = argc == 4 ? atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (!threads)
+        threads = 1;
 
-    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    std::cout << "using " << src << " as source directory and writing output to " << dest << " on " << threads << " threads" << std::endl;
+
+    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest, threads);
 
     if (!ta->convertWorld2())
     {
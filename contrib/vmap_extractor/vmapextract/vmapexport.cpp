@@ -21,6 +21,10 @@
 #include <iostream>
 #include <vector>
 #include <list>
+#include <set>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <errno.h>
 
 #ifdef _WIN32
@@ -71,6 +75,7 @@ char output_path[128] = ".";
 char input_path[1024] = ".";
 bool hasInputPathParam = false;
 bool preciseVectorData = false;
+unsigned int extractThreads = 1;
 
 // Constants
 
@@ -121,24 +126,67 @@ void ReadLiquidTypeTableDBC()
     printf("Done! (%u LiqTypes loaded)\n", (unsigned int)LiqType_count);
 }
 
-bool ExtractWmo()
+uint32 GetMSTimeSince(std::chrono::steady_clock::time_point start)
 {
-    bool success = true;
+    return uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+void ExtractWmoWorker(vector<string>* wmoFiles, std::atomic<uint32>* nextFile, std::atomic<bool>* success)
+{
+    while (*success)
+    {
+        uint32 index = (*nextFile)++;
+        if (index >= wmoFiles->size())
+            break;
+
+        if (!ExtractSingleWmo((*wmoFiles)[index]))
+            *success = false;
+    }
+}
 
+bool ExtractWmo()
+{
     //const char* ParsArchiveNames[] = {"patch-2.MPQ", "patch.MPQ", "common.MPQ", "expansion.MPQ"};
 
-    for (ArchiveSet::const_iterator ar_itr = gOpenArchives.begin(); ar_itr != gOpenArchives.end() && success; ++ar_itr)
+    // one entry per output file, the first archive listing it wins as before
+    vector<string> wmoFiles;
+    std::set<string> localFiles;
+    for (ArchiveSet::const_iterator ar_itr = gOpenArchives.begin(); ar_itr != gOpenArchives.end(); ++ar_itr)
     {
         vector<string> filelist;
 
         (*ar_itr)->GetFileListTo(filelist);
-        for (vector<string>::iterator fname = filelist.begin(); fname != filelist.end() && success; ++fname)
+        for (vector<string>::iterator fname = filelist.begin(); fname != filelist.end(); ++fname)
         {
-            if (fname->find(".wmo") != string::npos)
-                success = ExtractSingleWmo(*fname);
+            if (fname->find(".wmo") == string::npos)
+                continue;
+
+            char szLocalFile[1024];
+            sprintf(szLocalFile, "%s/%s", szWorkDirWmo, GetPlainName(fname->c_str()));
+            fixnamen(szLocalFile, strlen(szLocalFile));
+
+            if (localFiles.insert(szLocalFile).second)
+                wmoFiles.push_back(*fname);
         }
     }
 
+    // archive reads are serialized, parsing and converting the groups runs on all threads
+    std::atomic<uint32> nextFile(0);
+    std::atomic<bool> success(true);
+
+    unsigned int threads = std::min(extractThreads, (unsigned int)wmoFiles.size());
+    if (threads > 1)
+    {
+        vector<std::thread> workers;
+        for (unsigned int i = 0; i < threads; ++i)
+            workers.push_back(std::thread(ExtractWmoWorker, &wmoFiles, &nextFile, &success));
+
+        for (unsigned int i = 0; i < threads; ++i)
+            workers[i].join();
+    }
+    else
+        ExtractWmoWorker(&wmoFiles, &nextFile, &success);
+
     if (success)
         printf("\nExtract wmo complete (No (fatal) errors)\n");
 
@@ -176,7 +224,7 @@ bool ExtractSingleWmo(std::string& fname)
         return true;
 
     bool file_ok = true;
-    std::cout << "Extracting " << fname << std::endl;
+    printf("Extracting %s\n", fname.c_str());
     WMORoot froot(fname);
     if (!froot.open())
     {
@@ -389,6 +437,9 @@ bool processArgv(int argc, char** argv)
     bool result = true;
     hasInputPathParam = false;
     preciseVectorData = false;
+    extractThreads = std::thread::hardware_concurrency();
+    if (!extractThreads)
+        extractThreads = 1;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -419,6 +470,18 @@ bool processArgv(int argc, char** argv)
         {
             preciseVectorData = true;
         }
+        else if (strcmp("-t", argv[i]) == 0)
+        {
+            if ((i + 1) < argc && atoi(argv[i + 1]) > 0)
+            {
+                extractThreads = atoi(argv[i + 1]);
+                ++i;
+            }
+            else
+            {
+                result = false;
+            }
+        }
         else
         {
             result = false;
@@ -428,10 +491,11 @@ bool processArgv(int argc, char** argv)
     if (!result)
     {
         printf("Extract for %s.\n", szRawVMAPMagic);
-        printf("%s [-?][-s][-l][-d <path>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-t <threads>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
+        printf("   -t <threads>: Number of threads converting wmo files, all cores by default.\n");
         printf("   -? : This message.\n");
     }
     return result;
@@ -499,7 +563,11 @@ int main(int argc, char** argv)
 
     // extract data
     if (success)
+    {
+        std::chrono::steady_clock::time_point stageStart = std::chrono::steady_clock::now();
         success = ExtractWmo();
+        printf("Extracting wmo files on %u threads took %u ms\n", extractThreads, GetMSTimeSince(stageStart));
+    }
 
     //xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
     //map.dbc
@@ -523,11 +591,17 @@ int main(int argc, char** argv)
 
 
         delete dbc;
+
+        // spawns are appended to dir_bin in map and tile order, the assembler output depends on it
+        std::chrono::steady_clock::time_point stageStart = std::chrono::steady_clock::now();
         ParsMapFiles();
+        printf("Processing maps took %u ms\n", GetMSTimeSince(stageStart));
         delete [] map_ids;
         //nError = ERROR_SUCCESS;
         // Extract models, listed in DameObjectDisplayInfo.dbc
+        stageStart = std::chrono::steady_clock::now();
         ExtractGameobjectModels();
+        printf("Extracting gameobject models took %u ms\n", GetMSTimeSince(stageStart));
     }
 
     printf("\n");
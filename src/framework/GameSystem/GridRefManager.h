@@ -21,8 +21,85 @@
 
 #include "Utilities/LinkedReference/RefManager.h"
 
+#include <memory>
+#include <vector>
+
 template<class OBJECT> class GridReference;
 
+/**
+ * Structure of arrays mirror of the 2D positions and bounding radii of the objects linked to
+ * a GridRefManager. It is filled only by references that opt in and report their position
+ * changes, objects linked by plain GridReference are not part of it.
+ *
+ * Range queries scan the contiguous coordinate arrays and touch only the objects that may be
+ * in range, instead of walking the linked list and dereferencing every object.
+ */
+template<class OBJECT>
+class GridRefIndex
+{
+    public:
+
+        uint32 Size() const { return uint32(i_refs.size()); }
+
+        uint32 Add(GridReference<OBJECT>* ref, float x, float y, float radius)
+        {
+            i_x.push_back(x);
+            i_y.push_back(y);
+            i_radius.push_back(radius);
+            i_refs.push_back(ref);
+            return uint32(i_refs.size() - 1);
+        }
+
+        void Update(uint32 slot, float x, float y, float radius)
+        {
+            i_x[slot] = x;
+            i_y[slot] = y;
+            i_radius[slot] = radius;
+        }
+
+        void Remove(uint32 slot)
+        {
+            uint32 last = uint32(i_refs.size() - 1);
+            if (slot != last)
+            {
+                i_x[slot] = i_x[last];
+                i_y[slot] = i_y[last];
+                i_radius[slot] = i_radius[last];
+                i_refs[slot] = i_refs[last];
+                i_refs[slot]->SetIndexSlot(slot);
+            }
+
+            i_x.pop_back();
+            i_y.pop_back();
+            i_radius.pop_back();
+            i_refs.pop_back();
+        }
+
+        // calls visitor(OBJECT*) for every object with dist2d < range + its bounding radius until
+        // it returns false, the visitor must not link or unlink objects of this manager
+        template<class VISITOR>
+        void VisitInRange(float x, float y, float range, VISITOR& visitor) const
+        {
+            uint32 size = Size();
+            for (uint32 i = 0; i < size; ++i)
+            {
+                float dx = i_x[i] - x;
+                float dy = i_y[i] - y;
+                float maxDist = range + i_radius[i];
+                if (dx * dx + dy * dy < maxDist * maxDist)
+                    if (!visitor(i_refs[i]->getSource()))
+                        return;
+            }
+        }
+
+    private:
+
+        std::vector<float> i_x;
+        std::vector<float> i_y;
+        std::vector<float> i_radius;
+        std::vector<GridReference<OBJECT>*> i_refs;
+};
+
 template<class OBJECT>
 class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
 {
@@ -30,6 +107,11 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
 
         typedef LinkedListHead::Iterator< GridReference<OBJECT> > iterator;
 
+        GridRefManager() {}
+
+        // references must be cleared while the position index still exists
+        ~GridRefManager() { this->clearReferences(); }
+
         GridReference<OBJECT>* getFirst()
         {
             return (GridReference<OBJECT>*)RefManager<GridRefManager<OBJECT>, OBJECT>::getFirst();
@@ -44,5 +126,21 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
         iterator end() { return iterator(nullptr); }
         iterator rbegin() { return iterator(getLast()); }
         iterator rend() { return iterator(nullptr); }
+
+        GridRefIndex<OBJECT>* GetIndex() { return i_index.get(); }
+
+        GridRefIndex<OBJECT>& GetOrCreateIndex()
+        {
+            if (!i_index)
+                i_index.reset(new GridRefIndex<OBJECT>());
+            return *i_index;
+        }
+
+        // true when every linked object is mirrored in the position index
+        bool IsFullyIndexed() const { return i_index && i_index->Size() == this->getSize(); }
+
+    private:
+
+        std::unique_ptr<GridRefIndex<OBJECT> > i_index;
 };
 #endif
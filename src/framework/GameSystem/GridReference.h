@@ -51,7 +51,7 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
     public:
 
         GridReference()
-            : Reference<GridRefManager<OBJECT>, OBJECT>()
+            : Reference<GridRefManager<OBJECT>, OBJECT>(), i_indexSlot(0)
         {
         }
 
@@ -64,6 +64,14 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
         {
             return (GridReference*)Reference<GridRefManager<OBJECT>, OBJECT>::next();
         }
+
+        // slot in the target's GridRefIndex, valid only for references that maintain it
+        uint32 GetIndexSlot() const { return i_indexSlot; }
+        void SetIndexSlot(uint32 slot) { i_indexSlot = slot; }
+
+    private:
+
+        uint32 i_indexSlot;
 };
 
 #endif
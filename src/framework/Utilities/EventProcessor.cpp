@@ -18,9 +18,12 @@
 
 #include "EventProcessor.h"
 
+#include <algorithm>
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_sequence = 0;
     m_aborting = false;
 }
 
@@ -35,12 +38,12 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_events.empty() && m_events.front()->m_execTime <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        std::pop_heap(m_events.begin(), m_events.end(), IsLater);
+        BasicEvent* Event = m_events.back();
+        m_events.pop_back();
 
         if (!Event->to_Abort)
         {
@@ -63,26 +66,32 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
+    // take the queue out, Abort() handlers are allowed to add new events
+    EventList events;
+    events.swap(m_events);
+
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    for (EventList::iterator i = events.begin(); i != events.end(); ++i)
     {
-        EventList::iterator i_old = i;
-        ++i;
-
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        (*i)->to_Abort = true;
+        (*i)->Abort(m_time);
+        if (force || (*i)->IsDeletable())
         {
-            delete i_old->second;
-
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
+            delete *i;
+            *i = nullptr;
         }
     }
 
     // fast clear event list (in force case)
     if (force)
-        m_events.clear();
+        return;
+
+    // keep not deletable events queued
+    for (EventList::const_iterator i = events.begin(); i != events.end(); ++i)
+        if (*i)
+            m_events.push_back(*i);
+
+    std::make_heap(m_events.begin(), m_events.end(), IsLater);
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -91,7 +100,9 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Event->m_sequence = m_sequence++;
+    m_events.push_back(Event);
+    std::push_heap(m_events.begin(), m_events.end(), IsLater);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
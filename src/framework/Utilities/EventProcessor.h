@@ -21,7 +21,7 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
@@ -53,9 +53,11 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
+        uint64 m_sequence;                                  // insertion order, keeps events with same execution time in FIFO order
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+// binary min-heap ordered by execution time, see EventProcessor::IsLater
+typedef std::vector<BasicEvent*> EventList;
 
 class EventProcessor
 {
@@ -71,7 +73,15 @@ class EventProcessor
 
     protected:
 
+        static bool IsLater(BasicEvent const* left, BasicEvent const* right)
+        {
+            if (left->m_execTime != right->m_execTime)
+                return left->m_execTime > right->m_execTime;
+            return left->m_sequence > right->m_sequence;
+        }
+
         uint64 m_time;
+        uint64 m_sequence;
         EventList m_events;
         bool m_aborting;
 };
@@ -0,0 +1,234 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OBJECTPOOL_H
+#define MANGOS_OBJECTPOOL_H
+
+#include "Platform/Define.h"
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace MaNGOS
+{
+    struct ObjectPoolStats
+    {
+        ObjectPoolStats() : objectSize(0), objectsPerSlab(0), liveObjects(0), freeObjects(0),
+            slabs(0), emptySlabs(0), allocations(0), fallbacks(0) {}
+
+        uint32 objectSize;                                  // size of one pooled object in bytes
+        uint32 objectsPerSlab;
+        uint32 liveObjects;                                 // objects currently handed out from slabs
+        uint32 freeObjects;                                 // free chunks in allocated slabs
+        uint32 slabs;                                       // allocated slabs, including empty ones
+        uint32 emptySlabs;                                  // slabs kept around without live objects
+        uint64 allocations;                                 // total allocations served from slabs
+        uint64 fallbacks;                                   // allocations of derived types passed to the global heap
+    };
+
+    /**
+     * Type specific slab allocator, used as backend of class level operator new/delete.
+     *
+     * Objects of exactly sizeof(T) are carved out of slabs of ObjectsPerSlab chunks, derived
+     * classes (other size) are passed through to the global heap. Slabs that become empty are
+     * kept up to MaxEmptySlabs to absorb grid load/unload churn, further ones are released.
+     */
+    template<class T>
+    class ObjectPool
+    {
+        public:
+            static uint32 const SlabTargetSize = 64 * 1024;
+            static uint32 const ObjectsPerSlab = sizeof(T) * 8 > SlabTargetSize ? 8 : SlabTargetSize / sizeof(T);
+            static uint32 const MaxEmptySlabs  = 2;
+
+            // never destroyed: pooled objects may still be released during static destruction
+            static ObjectPool& Instance()
+            {
+                static ObjectPool* instance = new ObjectPool();
+                return *instance;
+            }
+
+            void* Allocate(size_t size)
+            {
+                if (size != sizeof(T))
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    ++m_fallbacks;
+                    return ::operator new(size);
+                }
+
+                std::lock_guard<std::mutex> guard(m_lock);
+
+                if (!m_available)
+                    LinkAvailable(CreateSlab());
+
+                Slab* slab = m_available;
+                if (slab->used == 0)
+                    --m_emptySlabs;
+
+                Chunk* chunk = slab->freeList;
+                slab->freeList = chunk->nextFree;
+                ++slab->used;
+                ++m_liveObjects;
+                ++m_allocations;
+
+                // slab full, no longer a candidate for allocations
+                if (!slab->freeList)
+                    UnlinkAvailable(slab);
+
+                return chunk->storage;
+            }
+
+            void Deallocate(void* ptr, size_t size)
+            {
+                if (!ptr)
+                    return;
+
+                if (size != sizeof(T))
+                {
+                    ::operator delete(ptr);
+                    return;
+                }
+
+                Chunk* chunk = reinterpret_cast<Chunk*>(static_cast<char*>(ptr) - offsetof(Chunk, storage));
+
+                std::lock_guard<std::mutex> guard(m_lock);
+
+                Slab* slab = chunk->slab;
+                bool wasFull = !slab->freeList;
+
+                chunk->nextFree = slab->freeList;
+                slab->freeList = chunk;
+                --slab->used;
+                --m_liveObjects;
+
+                if (wasFull)
+                    LinkAvailable(slab);
+
+                if (slab->used == 0)
+                {
+                    if (m_emptySlabs < MaxEmptySlabs)
+                        ++m_emptySlabs;
+                    else
+                    {
+                        UnlinkAvailable(slab);
+                        delete slab;
+                        --m_slabs;
+                    }
+                }
+            }
+
+            ObjectPoolStats GetStats() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+
+                ObjectPoolStats stats;
+                stats.objectSize = sizeof(T);
+                stats.objectsPerSlab = ObjectsPerSlab;
+                stats.liveObjects = m_liveObjects;
+                stats.freeObjects = m_slabs * ObjectsPerSlab - m_liveObjects;
+                stats.slabs = m_slabs;
+                stats.emptySlabs = m_emptySlabs;
+                stats.allocations = m_allocations;
+                stats.fallbacks = m_fallbacks;
+                return stats;
+            }
+
+        private:
+            struct Slab;
+
+            struct Chunk
+            {
+                Slab* slab;
+                union
+                {
+                    Chunk* nextFree;
+                    alignas(T) char storage[sizeof(T)];
+                };
+            };
+
+            struct Slab
+            {
+                Slab* prev;
+                Slab* next;
+                Chunk* freeList;
+                uint32 used;
+                Chunk chunks[ObjectsPerSlab];
+            };
+
+            ObjectPool() : m_available(nullptr), m_slabs(0), m_emptySlabs(0), m_liveObjects(0), m_allocations(0), m_fallbacks(0) {}
+            ObjectPool(ObjectPool const&);
+            ObjectPool& operator=(ObjectPool const&);
+
+            Slab* CreateSlab()
+            {
+                Slab* slab = new Slab;
+                slab->prev = nullptr;
+                slab->next = nullptr;
+                slab->used = 0;
+                slab->freeList = nullptr;
+
+                // build free list backwards so allocations walk the slab in address order
+                for (uint32 i = ObjectsPerSlab; i > 0; --i)
+                {
+                    Chunk& chunk = slab->chunks[i - 1];
+                    chunk.slab = slab;
+                    chunk.nextFree = slab->freeList;
+                    slab->freeList = &chunk;
+                }
+
+                ++m_slabs;
+                ++m_emptySlabs;
+                return slab;
+            }
+
+            void LinkAvailable(Slab* slab)
+            {
+                slab->prev = nullptr;
+                slab->next = m_available;
+                if (m_available)
+                    m_available->prev = slab;
+                m_available = slab;
+            }
+
+            void UnlinkAvailable(Slab* slab)
+            {
+                if (slab->prev)
+                    slab->prev->next = slab->next;
+                else
+                    m_available = slab->next;
+
+                if (slab->next)
+                    slab->next->prev = slab->prev;
+
+                slab->prev = nullptr;
+                slab->next = nullptr;
+            }
+
+            mutable std::mutex m_lock;
+            Slab* m_available;                              // slabs with at least one free chunk
+            uint32 m_slabs;
+            uint32 m_emptySlabs;
+            uint32 m_liveObjects;
+            uint64 m_allocations;
+            uint64 m_fallbacks;
+    };
+}
+
+#endif
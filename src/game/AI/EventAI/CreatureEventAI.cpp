@@ -72,6 +72,13 @@ void CreatureEventAI::GetAIInformation(ChatHandler& reader)
         else
             reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) action[type(param1)]:  %2u(%5u)", itr->Event.event_id, uint32(itr->Event.event_type), itr->Enabled ? "On" : "Off", itr->Time / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1);
     }
+
+    if (m_EventStats)
+    {
+        uint32 evaluated = m_EventStats->evaluated.load(std::memory_order_relaxed);
+        uint32 seconds = WorldTimer::getMSTimeDiff(m_EventStats->startTime, WorldTimer::getMSTime()) / IN_MILLISECONDS;
+        reader.PSendSysMessage("Events evaluated for entry %u: %u (%.2f per second)", m_creature->GetEntry(), evaluated, seconds ? float(evaluated) / seconds : float(evaluated));
+    }
 }
 
 // For Non Dungeon map only allow non-difficulty flags or EFLAG_NORMAL mode
@@ -92,6 +99,9 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
     m_LastSpellMaxRange(0),
     m_reactState(REACT_AGGRESSIVE)
 {
+    memset(m_EventTypeOffset, 0, sizeof(m_EventTypeOffset));
+    m_EventStats = sEventAIMgr.GetCreatureEventAIStats(m_creature->GetEntry());
+
     // Need make copy for filter unneeded steps and safe in case table reload
     CreatureEventAI_Event_Map::const_iterator creatureEventsItr = sEventAIMgr.GetCreatureEventAIMap().find(m_creature->GetEntry());
     if (creatureEventsItr != sEventAIMgr.GetCreatureEventAIMap().end())
@@ -121,6 +131,9 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
             sLog.outErrorEventAI("Creature %u has events but no events added to list because of instance flags (spawned in map %u, difficulty %u).", m_creature->GetEntry(), m_creature->GetMapId(), m_creature->GetMap()->GetDifficulty());
         else
         {
+            // position in m_CreatureEventAIList for every stored event of the entry
+            std::vector<int32> holderPos(creatureEvent.size(), -1);
+
             m_CreatureEventAIList.reserve(events_count);
             for (CreatureEventAI_Event_Vec::const_iterator i = creatureEvent.begin(); i != creatureEvent.end(); ++i)
             {
@@ -140,12 +153,29 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
 
                 if (storeEvent)
                 {
-                    m_CreatureEventAIList.push_back(CreatureEventAIHolder(*i));
+                    holderPos[i - creatureEvent.begin()] = int32(m_CreatureEventAIList.size());
+                    m_CreatureEventAIList.push_back(CreatureEventAIHolder(*i, IsTimerBasedEvent(EventAI_Type(i->event_type))));
                     // Cache for fast use
                     if (i->event_type == EVENT_T_OOC_LOS)
                         m_HasOOCLoSEvent = true;
                 }
             }
+
+            // Build the per type dispatch of this creature from the compiled table of the entry
+            CreatureEventAI_Dispatch_Map::const_iterator dispatchItr = sEventAIMgr.GetCreatureEventAIDispatchMap().find(m_creature->GetEntry());
+            if (dispatchItr != sEventAIMgr.GetCreatureEventAIDispatchMap().end())
+            {
+                CreatureEventAI_DispatchTable const& table = dispatchItr->second;
+                m_EventsByType.reserve(m_CreatureEventAIList.size());
+                for (uint32 type = 0; type < EVENT_T_END; ++type)
+                {
+                    m_EventTypeOffset[type] = uint16(m_EventsByType.size());
+                    for (uint32 j = table.typeOffset[type]; j < table.typeOffset[type + 1]; ++j)
+                        if (holderPos[table.eventsByType[j]] >= 0)
+                            m_EventsByType.push_back(uint16(holderPos[table.eventsByType[j]]));
+                }
+                m_EventTypeOffset[EVENT_T_END] = uint16(m_EventsByType.size());
+            }
         }
     }
     else
@@ -189,15 +219,18 @@ bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pAction
     if (!pHolder.Enabled || pHolder.Time)
         return false;
 
+    if (m_EventStats)
+        m_EventStats->evaluated.fetch_add(1, std::memory_order_relaxed);
+
     // Check the inverse phase mask (event doesn't trigger if current phase bit is set in mask)
     if (pHolder.Event.event_inverse_phase_mask & (1 << m_Phase))
     {
-        if (!IsTimerBasedEvent(pHolder.Event.event_type))
+        if (!pHolder.TimerBased)
             DEBUG_FILTER_LOG(LOG_FILTER_EVENT_AI_DEV, "CreatureEventAI: Event %u skipped because of phasemask %u. Current phase %u", pHolder.Event.event_id, pHolder.Event.event_inverse_phase_mask, m_Phase);
         return false;
     }
 
-    if (!IsTimerBasedEvent(pHolder.Event.event_type))
+    if (!pHolder.TimerBased)
         LOG_PROCESS_EVENT;
 
     CreatureEventAI_Event const& event = pHolder.Event;
@@ -1156,11 +1189,8 @@ void CreatureEventAI::Reset()
 
 void CreatureEventAI::JustReachedHome()
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_REACHED_HOME)
-            ProcessEvent(*i);
-    }
+    for (uint32 i = m_EventTypeOffset[EVENT_T_REACHED_HOME]; i < m_EventTypeOffset[EVENT_T_REACHED_HOME + 1]; ++i)
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[i]]);
 
     Reset();
 }
@@ -1178,11 +1208,8 @@ void CreatureEventAI::EnterEvadeMode()
     m_creature->SetLootRecipient(nullptr);
 
     // Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_EVADE)
-            ProcessEvent(*i);
-    }
+    for (uint32 i = m_EventTypeOffset[EVENT_T_EVADE]; i < m_EventTypeOffset[EVENT_T_EVADE + 1]; ++i)
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[i]]);
 }
 
 void CreatureEventAI::JustDied(Unit* killer)
@@ -1200,11 +1227,8 @@ void CreatureEventAI::JustDied(Unit* killer)
         SendAIEventAround(AI_EVENT_JUST_DIED, killer, 0, AIEVENT_DEFAULT_THROW_RADIUS);
 
     // Handle On Death events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_DEATH)
-            ProcessEvent(*i, killer);
-    }
+    for (uint32 i = m_EventTypeOffset[EVENT_T_DEATH]; i < m_EventTypeOffset[EVENT_T_DEATH + 1]; ++i)
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[i]], killer);
 
     // reset phase after any death state events
     m_Phase = 0;
@@ -1215,49 +1239,37 @@ void CreatureEventAI::KilledUnit(Unit* victim)
     if (victim->GetTypeId() != TYPEID_PLAYER)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_KILL)
-            ProcessEvent(*i, victim);
-    }
+    for (uint32 i = m_EventTypeOffset[EVENT_T_KILL]; i < m_EventTypeOffset[EVENT_T_KILL + 1]; ++i)
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[i]], victim);
 }
 
 void CreatureEventAI::JustSummoned(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_SUMMONED_UNIT)
-            ProcessEvent(*i, pUnit);
-    }
+    for (uint32 i = m_EventTypeOffset[EVENT_T_SUMMONED_UNIT]; i < m_EventTypeOffset[EVENT_T_SUMMONED_UNIT + 1]; ++i)
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[i]], pUnit);
 }
 
 void CreatureEventAI::SummonedCreatureJustDied(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-            ProcessEvent(*i, pUnit);
-    }
+    for (uint32 i = m_EventTypeOffset[EVENT_T_SUMMONED_JUST_DIED]; i < m_EventTypeOffset[EVENT_T_SUMMONED_JUST_DIED + 1]; ++i)
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[i]], pUnit);
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-            ProcessEvent(*i, pUnit);
-    }
+    for (uint32 i = m_EventTypeOffset[EVENT_T_SUMMONED_JUST_DESPAWN]; i < m_EventTypeOffset[EVENT_T_SUMMONED_JUST_DESPAWN + 1]; ++i)
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[i]], pUnit);
 }
 
 void CreatureEventAI::ReceiveAIEvent(AIEventType eventType, Creature* pSender, Unit* pInvoker, uint32 /*miscValue*/)
 {
     MANGOS_ASSERT(pSender);
 
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (uint32 i = m_EventTypeOffset[EVENT_T_RECEIVE_AI_EVENT]; i < m_EventTypeOffset[EVENT_T_RECEIVE_AI_EVENT + 1]; ++i)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_AI_EVENT &&
-                itr->Event.receiveAIEvent.eventType == eventType && (!itr->Event.receiveAIEvent.senderEntry || itr->Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
-            ProcessEvent(*itr, pInvoker, pSender);
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[i]];
+        if (holder.Event.receiveAIEvent.eventType == eventType && (!holder.Event.receiveAIEvent.senderEntry || holder.Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
+            ProcessEvent(holder, pInvoker, pSender);
     }
 }
 
@@ -1310,21 +1322,20 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
     // Check for OOC LOS Event
     if (m_HasOOCLoSEvent && !m_creature->getVictim())
     {
-        for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+        for (uint32 i = m_EventTypeOffset[EVENT_T_OOC_LOS]; i < m_EventTypeOffset[EVENT_T_OOC_LOS + 1]; ++i)
         {
-            if (itr->Event.event_type == EVENT_T_OOC_LOS)
-            {
-                // can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)itr->Event.ooc_los.maxRange;
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[i]];
 
-                // if friendly event && who is not hostile OR hostile event && who is hostile
-                if ((itr->Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
-                        ((!itr->Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
-                {
-                    // if range is ok and we are actually in LOS
-                    if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                        ProcessEvent(*itr, who);
-                }
+            // can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)holder.Event.ooc_los.maxRange;
+
+            // if friendly event && who is not hostile OR hostile event && who is hostile
+            if ((holder.Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
+                    ((!holder.Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+            {
+                // if range is ok and we are actually in LOS
+                if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
+                    ProcessEvent(holder, who);
             }
         }
     }
@@ -1354,12 +1365,14 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
 
 void CreatureEventAI::SpellHit(Unit* pUnit, const SpellEntry* pSpell)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        if (i->Event.event_type == EVENT_T_SPELLHIT)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i->Event.spell_hit.spellId || pSpell->Id == i->Event.spell_hit.spellId)
-                if (pSpell->SchoolMask & i->Event.spell_hit.schoolMask)
-                    ProcessEvent(*i, pUnit);
+    for (uint32 i = m_EventTypeOffset[EVENT_T_SPELLHIT]; i < m_EventTypeOffset[EVENT_T_SPELLHIT + 1]; ++i)
+    {
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[i]];
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!holder.Event.spell_hit.spellId || pSpell->Id == holder.Event.spell_hit.spellId)
+            if (pSpell->SchoolMask & holder.Event.spell_hit.schoolMask)
+                ProcessEvent(holder, pUnit);
+    }
 }
 
 void CreatureEventAI::UpdateAI(const uint32 diff)
@@ -1392,7 +1405,7 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
             if (!(i->Enabled) || i->Time)
                 continue;
 
-            if (IsTimerBasedEvent(i->Event.event_type))
+            if (i->TimerBased)
                 ProcessEvent(*i);
         }
 
@@ -1561,19 +1574,17 @@ void CreatureEventAI::DoFindFriendlyMissingBuff(std::list<Creature*>& _list, flo
 
 void CreatureEventAI::ReceiveEmote(Player* pPlayer, uint32 text_emote)
 {
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (uint32 i = m_EventTypeOffset[EVENT_T_RECEIVE_EMOTE]; i < m_EventTypeOffset[EVENT_T_RECEIVE_EMOTE + 1]; ++i)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_EMOTE)
-        {
-            if (itr->Event.receive_emote.emoteId != text_emote)
-                continue;
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[i]];
+        if (holder.Event.receive_emote.emoteId != text_emote)
+            continue;
 
-            PlayerCondition pcon(0, itr->Event.receive_emote.condition, itr->Event.receive_emote.conditionValue1, itr->Event.receive_emote.conditionValue2);
-            if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
-                ProcessEvent(*itr, pPlayer);
-            }
+        PlayerCondition pcon(0, holder.Event.receive_emote.condition, holder.Event.receive_emote.conditionValue1, holder.Event.receive_emote.conditionValue2);
+        if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
+            ProcessEvent(holder, pPlayer);
         }
     }
 }
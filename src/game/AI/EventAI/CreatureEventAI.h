@@ -23,6 +23,9 @@
 #include "Entities/Creature.h"
 #include "AI/BaseAI/CreatureAI.h"
 #include "Entities/Unit.h"
+#include "Timer.h"
+
+#include <atomic>
 
 class Player;
 class WorldObject;
@@ -646,13 +649,36 @@ struct CreatureEventAI_Summon
 // EventSummon_Map
 typedef std::unordered_map<uint32, CreatureEventAI_Summon> CreatureEventAI_Summon_Map;
 
+// Positions in the event vector of one creature entry grouped by event type, compiled at load
+struct CreatureEventAI_DispatchTable
+{
+    std::vector<uint16> eventsByType;                       // list order is kept inside one event type
+    uint16 typeOffset[EVENT_T_END + 1];                     // events of type T are at [typeOffset[T], typeOffset[T + 1])
+};
+
+// EventDispatch_Map
+typedef std::unordered_map<uint32, CreatureEventAI_DispatchTable> CreatureEventAI_Dispatch_Map;
+
+// Evaluation counters per creature entry, entries are never removed so pointers stay valid over reloads
+struct CreatureEventAI_Stats
+{
+    CreatureEventAI_Stats() : evaluated(0), startTime(WorldTimer::getMSTime()) {}
+
+    std::atomic<uint32> evaluated;                          // ProcessEvent calls of all creatures of the entry
+    uint32 startTime;
+};
+
+// EventStats_Map
+typedef std::unordered_map<uint32, CreatureEventAI_Stats> CreatureEventAI_Stats_Map;
+
 struct CreatureEventAIHolder
 {
-    CreatureEventAIHolder(CreatureEventAI_Event p) : Event(p), Time(0), Enabled(true) {}
+    CreatureEventAIHolder(CreatureEventAI_Event p, bool timerBased) : Event(p), Time(0), Enabled(true), TimerBased(timerBased) {}
 
     CreatureEventAI_Event Event;
     uint32 Time;
     bool Enabled;
+    bool TimerBased;                                        // cached IsTimerBasedEvent(Event.event_type)
 
     // helper
     bool UpdateRepeatTimer(Creature* creature, uint32 repeatMin, uint32 repeatMax);
@@ -715,6 +741,11 @@ class CreatureEventAI : public CreatureAI
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid)
 
+        // Positions in m_CreatureEventAIList grouped by event type, so hooks only touch their own events
+        std::vector<uint16> m_EventsByType;
+        uint16 m_EventTypeOffset[EVENT_T_END + 1];
+        CreatureEventAI_Stats* m_EventStats;                // Shared evaluation counter of the creature entry
+
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_MeleeEnabled;                              // If we allow melee auto attack
         bool   m_DynamicMovement;                           // Core will control creatures movement if this is enabled
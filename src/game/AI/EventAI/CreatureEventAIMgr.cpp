@@ -242,11 +242,46 @@ bool IsValidTargetType(EventAI_Type eventType, EventAI_ActionType actionType, ui
     }
 }
 
+void CreatureEventAIMgr::CompileCreatureEventAI_DispatchTables()
+{
+    for (CreatureEventAI_Event_Map::const_iterator itr = m_CreatureEventAI_Event_Map.begin(); itr != m_CreatureEventAI_Event_Map.end(); ++itr)
+    {
+        CreatureEventAI_Event_Vec const& events = itr->second;
+        CreatureEventAI_DispatchTable& table = m_CreatureEventAI_Dispatch_Map[itr->first];
+
+        // counting sort by event type, stable so events of one type keep their list order
+        uint16 count[EVENT_T_END] = {};
+        for (size_t i = 0; i < events.size(); ++i)
+            ++count[events[i].event_type];
+
+        table.typeOffset[0] = 0;
+        for (uint32 type = 0; type < EVENT_T_END; ++type)
+            table.typeOffset[type + 1] = table.typeOffset[type] + count[type];
+
+        uint16 insertPos[EVENT_T_END];
+        memcpy(insertPos, table.typeOffset, sizeof(insertPos));
+
+        table.eventsByType.resize(events.size());
+        for (size_t i = 0; i < events.size(); ++i)
+            table.eventsByType[insertPos[events[i].event_type]++] = uint16(i);
+
+        // stats survive reloads, creatures keep pointers to them
+        m_CreatureEventAI_Stats_Map[itr->first];
+    }
+}
+
+CreatureEventAI_Stats* CreatureEventAIMgr::GetCreatureEventAIStats(uint32 entry)
+{
+    CreatureEventAI_Stats_Map::iterator itr = m_CreatureEventAI_Stats_Map.find(entry);
+    return itr != m_CreatureEventAI_Stats_Map.end() ? &itr->second : nullptr;
+}
+
 // -------------------
 void CreatureEventAIMgr::LoadCreatureEventAI_Scripts()
 {
     // Drop Existing EventAI List
     m_CreatureEventAI_Event_Map.clear();
+    m_CreatureEventAI_Dispatch_Map.clear();
     std::set<int32> usedTextIds;
 
     // Gather event data
@@ -936,6 +971,7 @@ void CreatureEventAIMgr::LoadCreatureEventAI_Scripts()
 
         CheckUnusedAITexts();
         CheckUnusedAISummons();
+        CompileCreatureEventAI_DispatchTables();
 
         sLog.outString(">> Loaded %u CreatureEventAI scripts", Count);
         sLog.outString();
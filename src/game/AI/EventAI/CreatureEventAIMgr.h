@@ -34,13 +34,19 @@ class CreatureEventAIMgr
 
         CreatureEventAI_Event_Map  const& GetCreatureEventAIMap()       const { return m_CreatureEventAI_Event_Map; }
         CreatureEventAI_Summon_Map const& GetCreatureEventAISummonMap() const { return m_CreatureEventAI_Summon_Map; }
+        CreatureEventAI_Dispatch_Map const& GetCreatureEventAIDispatchMap() const { return m_CreatureEventAI_Dispatch_Map; }
+
+        CreatureEventAI_Stats* GetCreatureEventAIStats(uint32 entry);
 
     private:
         void CheckUnusedAITexts();
         void CheckUnusedAISummons();
+        void CompileCreatureEventAI_DispatchTables();
 
         CreatureEventAI_Event_Map  m_CreatureEventAI_Event_Map;
         CreatureEventAI_Summon_Map m_CreatureEventAI_Summon_Map;
+        CreatureEventAI_Dispatch_Map m_CreatureEventAI_Dispatch_Map;
+        CreatureEventAI_Stats_Map m_CreatureEventAI_Stats_Map;
 
         uint32 m_usedTextsAmount;
 };
@@ -102,9 +102,7 @@ void Channel::Join(Player* player, const char* password)
 
     data.clear();
 
-    PlayerInfo& pinfo = m_players[guid];
-    pinfo.player = guid;
-    pinfo.flags = MEMBER_FLAG_NONE;
+    AddMember(player);
 
     MakeYouJoined(data);
     SendToOne(data, guid);
@@ -146,7 +144,7 @@ void Channel::Leave(Player* player, bool send)
 
     bool changeowner = m_players[guid].IsOwner();
 
-    m_players.erase(guid);
+    RemoveMember(guid);
     if (m_announce && (player->GetSession()->GetSecurity() < SEC_GAMEMASTER || !sWorld.getConfig(CONFIG_BOOL_SILENTLY_GM_JOIN_TO_CHANNEL)))
     {
         WorldPacket data;
@@ -223,7 +221,7 @@ void Channel::KickOrBan(Player* player, const char* targetName, bool ban)
         MakePlayerKicked(data, targetGuid, guid);
 
     SendToAll(data);
-    m_players.erase(targetGuid);
+    RemoveMember(targetGuid);
     target->LeftChannel(this);
 
     if (changeowner)
@@ -469,7 +467,7 @@ void Channel::List(Player* player)
     uint32 count  = 0;
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
     {
-        Player* plr = sObjectMgr.GetPlayer(i->first);
+        Player* plr = i->second.handle;
 
         // PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
         // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
@@ -678,12 +676,50 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
     }
 }
 
+void Channel::AddMember(Player* player)
+{
+    PlayerInfo& pinfo = m_players[player->GetObjectGuid()];
+    pinfo.player = player->GetObjectGuid();
+    pinfo.flags = MEMBER_FLAG_NONE;
+    pinfo.handle = player;
+    pinfo.memberIndex = m_members.size();
+
+    m_members.push_back(player);
+}
+
+void Channel::RemoveMember(ObjectGuid guid)
+{
+    PlayerList::iterator itr = m_players.find(guid);
+    if (itr == m_players.end())
+        return;
+
+    // move the last member into the gap
+    if (itr->second.handle)
+    {
+        uint32 index = itr->second.memberIndex;
+        Player* last = m_members.back();
+        m_members[index] = last;
+        m_players[last->GetObjectGuid()].memberIndex = index;
+        m_members.pop_back();
+    }
+
+    m_players.erase(itr);
+}
+
 void Channel::SendToAll(WorldPacket const& data, ObjectGuid guid) const
 {
-    for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        if (Player* plr = sObjectMgr.GetPlayer(i->first))
-            if (!guid || !plr->GetSocial()->HasIgnore(guid))
-                plr->GetSession()->SendPacket(data);
+    // members ignoring the sender are resolved once per message, not per member
+    std::vector<uint32> ignoring;
+    if (guid)
+        sSocialMgr.GetIgnoringPlayers(guid.GetCounter(), ignoring);
+
+    for (MemberList::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+    {
+        if (!ignoring.empty() && std::binary_search(ignoring.begin(), ignoring.end(), (*itr)->GetGUIDLow()))
+            continue;
+
+        (*itr)->GetSession()->SendPacket(data);
+    }
 }
 
 void Channel::SendToOne(WorldPacket const& data, ObjectGuid who) const
@@ -118,8 +118,12 @@ class Channel
 
         struct PlayerInfo
         {
+            PlayerInfo() : flags(MEMBER_FLAG_NONE), handle(nullptr), memberIndex(0) {}
+
             ObjectGuid player;
             uint8 flags;
+            Player* handle;                                 // valid while member, players leave all channels at logout
+            uint32 memberIndex;                             // position in m_members
 
             bool HasFlag(uint8 flag) const { return !!(flags & flag); }
             void SetFlag(uint8 flag) { if (!HasFlag(flag)) flags |= flag; }
@@ -226,6 +230,9 @@ class Channel
         void SendToAll(WorldPacket const& data, ObjectGuid guid = ObjectGuid()) const;
         void SendToOne(WorldPacket const& data, ObjectGuid who) const;
 
+        void AddMember(Player* player);
+        void RemoveMember(ObjectGuid guid);
+
         bool IsOn(ObjectGuid who) const { return m_players.find(who) != m_players.end(); }
         bool IsBanned(ObjectGuid guid) const { return m_banned.find(guid) != m_banned.end(); }
 
@@ -275,6 +282,8 @@ class Channel
 
         typedef     std::map<ObjectGuid, PlayerInfo> PlayerList;
         PlayerList  m_players;
+        typedef     std::vector<Player*> MemberList;
+        MemberList  m_members;                              // contiguous copy of the handles for message fan-out
         GuidSet m_banned;
 };
 #endif
@@ -642,9 +642,12 @@ ChatCommand* ChatHandler::getCommandTable()
         { "log",            SEC_CONSOLE,        true,  nullptr,                                        "", serverLogCommandTable },
         { "motd",           SEC_PLAYER,         true,  &ChatHandler::HandleServerMotdCommand,          "", nullptr },
         { "plimit",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerPLimitCommand,        "", nullptr },
+        { "profile",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerProfileCommand,       "", nullptr },
+        { "pools",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerPoolsCommand,         "", nullptr },
         { "resetallraid",   SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerResetAllRaidCommand,  "", nullptr },
         { "restart",        SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverRestartCommandTable },
         { "shutdown",       SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverShutdownCommandTable },
+        { "tick",           SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerTickCommand,          "", nullptr },
         { "set",            SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverSetCommandTable },
         { nullptr,          0,                  false, nullptr,                                        "", nullptr }
     };
@@ -497,11 +497,14 @@ class ChatHandler
         bool HandleServerLogLevelCommand(char* args);
         bool HandleServerMotdCommand(char* args);
         bool HandleServerPLimitCommand(char* args);
+        bool HandleServerPoolsCommand(char* args);
+        bool HandleServerProfileCommand(char* args);
         bool HandleServerResetAllRaidCommand(char* args);
         bool HandleServerRestartCommand(char* args);
         bool HandleServerSetMotdCommand(char* args);
         bool HandleServerShutDownCommand(char* args);
         bool HandleServerShutDownCancelCommand(char* args);
+        bool HandleServerTickCommand(char* args);
 
         bool HandleTeleCommand(char* args);
         bool HandleTeleAddCommand(char* args);
@@ -50,6 +50,8 @@
 #include "MotionGenerators/TargetedMovementGenerator.h"     // for HandleNpcUnFollowCommand
 #include "MotionGenerators/MoveMap.h"                       // for mmap manager
 #include "MotionGenerators/PathFinder.h"                    // for mmap commands
+#include "MotionGenerators/PathFinderService.h"             // for mmap stats
+#include "MotionGenerators/PathCorridorCache.h"             // for mmap stats
 #include "Movement/MoveSplineInit.h"
 
 #include <fstream>
@@ -4914,15 +4916,42 @@ bool ChatHandler::HandleMmapLoadedTilesCommand(char* /*args*/)
     return true;
 }
 
-bool ChatHandler::HandleMmapStatsCommand(char* /*args*/)
+bool ChatHandler::HandleMmapStatsCommand(char* args)
 {
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        sPathFinderService.ResetStats();
+        PathCorridorCache::ResetStats();
+        PSendSysMessage("Path search stats reset.");
+        return true;
+    }
+
     PSendSysMessage("mmap stats:");
     PSendSysMessage("  global mmap pathfinding is %sabled", sWorld.getConfig(CONFIG_BOOL_MMAP_ENABLED) ? "en" : "dis");
 
     MMAP::MMapManager* manager = MMAP::MMapFactory::createOrGetMMapManager();
     PSendSysMessage(" %u maps loaded with %u tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
 
-    const dtNavMesh* navmesh = manager->GetNavMesh(m_session->GetPlayer()->GetMapId());
+    if (sPathFinderService.IsActive())
+    {
+        PathFinderServiceStats stats;
+        sPathFinderService.GetStats(stats);
+
+        PSendSysMessage("Path searches on %u threads: queue %u (max %u)", stats.threads, stats.queueDepth, stats.maxQueueDepth);
+        PSendSysMessage(" " UI64FMTD " submitted, " UI64FMTD " deduplicated, " UI64FMTD " abandoned, " UI64FMTD " completed",
+                        stats.submitted, stats.deduplicated, stats.abandoned, stats.completed);
+        PSendSysMessage(" latency p50 %u us, p99 %u us over the last %u searches", stats.latencyP50, stats.latencyP99, stats.latencySamples);
+    }
+
+    uint64 corridorHits = PathCorridorCache::GetHits();
+    uint64 corridorSearches = corridorHits + PathCorridorCache::GetMisses();
+    PSendSysMessage("Shared corridors: " UI64FMTD " of " UI64FMTD " searches (%.1f%%), %u cached on current map",
+                    corridorHits, corridorSearches, corridorSearches ? corridorHits * 100.0f / corridorSearches : 0.0f,
+                    m_session->GetPlayer()->GetMap()->GetPathCorridorCache()->GetCorridorCount());
+
+    // tiles of the map may be loaded by other instances meanwhile
+    MMAP::NavMeshReadGuard guard(manager, m_session->GetPlayer()->GetMapId());
+    const dtNavMesh* navmesh = guard.GetNavMesh();
     if (!navmesh)
     {
         PSendSysMessage("NavMesh not loaded for current map.");
@@ -26,10 +26,13 @@
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "Entities/Player.h"
 #include "Entities/GameObject.h"
+#include "Entities/DynamicObject.h"
+#include "Entities/Corpse.h"
 #include "Chat/Chat.h"
 #include "Log.h"
 #include "Guilds/Guild.h"
 #include "Guilds/GuildMgr.h"
+#include "Groups/Group.h"
 #include "Globals/ObjectAccessor.h"
 #include "Maps/MapManager.h"
 #include "Mails/MassMailMgr.h"
@@ -4555,6 +4558,7 @@ static bool HandleResetStatsOrLevelHelper(Player* player)
         player->SetShapeshiftForm(FORM_NONE);
 
     player->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_WORLD_OBJECT_SIZE);
+    player->UpdateGridIndex();
     player->SetFloatValue(UNIT_FIELD_COMBATREACH, 1.5f);
 
     player->setFactionForRace(player->getRace());
@@ -4736,9 +4740,10 @@ bool ChatHandler::HandleResetAllCommand(char* args)
     }
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'", atLogin, atLogin);
-    HashMapHolder<Player>::MapType const& plist = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
-        itr->second->SetAtLoginFlag(atLogin);
+    HashMapHolder<Player>::ObjectList players;
+    sObjectAccessor.GetPlayers(players);
+    for (HashMapHolder<Player>::ObjectList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        (*itr)->SetAtLoginFlag(atLogin);
 
     return true;
 }
@@ -6754,3 +6759,97 @@ bool ChatHandler::HandleServerResetAllRaidCommand(char* args)
     return true;
 }
 
+
+template<class T>
+static void SendObjectPoolStats(ChatHandler* handler, char const* name)
+{
+    MaNGOS::ObjectPoolStats stats = MaNGOS::ObjectPool<T>::Instance().GetStats();
+    handler->PSendSysMessage("%s (%u bytes): live %u, free %u, slabs %u (empty %u, %u objects each), allocations " UI64FMTD ", heap fallbacks " UI64FMTD,
+                             name, stats.objectSize, stats.liveObjects, stats.freeObjects, stats.slabs, stats.emptySlabs, stats.objectsPerSlab,
+                             stats.allocations, stats.fallbacks);
+}
+
+bool ChatHandler::HandleServerPoolsCommand(char* /*args*/)
+{
+    SendObjectPoolStats<Creature>(this, "Creature");
+    SendObjectPoolStats<GameObject>(this, "GameObject");
+    SendObjectPoolStats<DynamicObject>(this, "DynamicObject");
+    SendObjectPoolStats<Corpse>(this, "Corpse");
+    return true;
+}
+
+bool ChatHandler::HandleServerProfileCommand(char* args)
+{
+    if (ExtractLiteralArg(&args, "on"))
+    {
+        uint32 interval = 60;
+        if (*args && !ExtractUInt32(&args, interval))
+            return false;
+
+        if (!interval)
+            return false;
+
+        sTickProfiler.Enable(interval * IN_MILLISECONDS);
+        PSendSysMessage("Tick profiler enabled, collapsed stacks are written to LogsDir every %u seconds.", interval);
+        return true;
+    }
+
+    if (ExtractLiteralArg(&args, "off"))
+    {
+        sTickProfiler.Disable();
+        SendSysMessage("Tick profiler disabled.");
+        return true;
+    }
+
+    if (TickProfiler::IsEnabled())
+        PSendSysMessage("Tick profiler is enabled, writing every %u seconds.", sTickProfiler.GetFlushInterval() / IN_MILLISECONDS);
+    else
+        SendSysMessage("Tick profiler is disabled.");
+
+    uint32 counts[TICK_HISTOGRAM_BUCKETS];
+    sTickProfiler.GetTickHistogram(counts);
+
+    SendSysMessage("Tick times of the last ticks:");
+    for (uint32 i = 0; i < TICK_HISTOGRAM_BUCKETS - 1; ++i)
+        PSendSysMessage("  < %4u ms: %u", TickProfiler::GetTickHistogramBound(i), counts[i]);
+    PSendSysMessage("  >= %3u ms: %u", TickProfiler::GetTickHistogramBound(TICK_HISTOGRAM_BUCKETS - 2), counts[TICK_HISTOGRAM_BUCKETS - 1]);
+    return true;
+}
+
+bool ChatHandler::HandleServerTickCommand(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        sWorld.ResetUpdatePhaseStats();
+        HashMapHolder<Player>::ResetStats();
+        HashMapHolder<Corpse>::ResetStats();
+        Group::ResetUpdateStats();
+        SendSysMessage("World update phase timings reset.");
+        return true;
+    }
+
+    uint64 ticks = sWorld.GetUpdatePhaseTicks();
+    PSendSysMessage("World update phase timings over " UI64FMTD " ticks (last / avg / max in microseconds):", ticks);
+
+    for (int i = 0; i < WUPDATE_PHASE_COUNT; ++i)
+    {
+        WorldUpdatePhaseStats const& stats = sWorld.GetUpdatePhaseStats(WorldUpdatePhase(i));
+        PSendSysMessage("  %-14s %8u %8u %8u", World::GetUpdatePhaseName(WorldUpdatePhase(i)), stats.last, ticks ? uint32(stats.total / ticks) : 0, stats.max);
+    }
+
+    HashMapHolderStats playerStats;
+    HashMapHolder<Player>::GetStats(playerStats);
+    PSendSysMessage("Player registry: " UI64FMTD " lookups (" UI64FMTD " waited), " UI64FMTD " updates (" UI64FMTD " waited)",
+                    playerStats.reads, playerStats.readWaits, playerStats.writes, playerStats.writeWaits);
+
+    HashMapHolderStats corpseStats;
+    HashMapHolder<Corpse>::GetStats(corpseStats);
+    PSendSysMessage("Corpse registry: " UI64FMTD " lookups (" UI64FMTD " waited), " UI64FMTD " updates (" UI64FMTD " waited)",
+                    corpseStats.reads, corpseStats.readWaits, corpseStats.writes, corpseStats.writeWaits);
+
+    GroupUpdateStats groupStats;
+    Group::GetUpdateStats(groupStats);
+    PSendSysMessage("Party member stats: " UI64FMTD " changed player updates, " UI64FMTD " packets built (" UI64FMTD " unchanged fields left out), " UI64FMTD " sent with " UI64FMTD " bytes",
+                    groupStats.changedTicks, groupStats.built, groupStats.droppedFields, groupStats.sent, groupStats.sentBytes);
+    return true;
+}
@@ -64,6 +64,8 @@ HostileReference::HostileReference(Unit* pUnit, ThreatManager* pThreatManager, f
     iUnitGuid = pUnit->GetObjectGuid();
     iOnline = true;
     iAccessible = true;
+    iHeapIndex = 0;
+    iInsertOrder = 0;
 }
 
 //============================================================
@@ -212,32 +214,110 @@ Unit* HostileReference::getSourceUnit() const
 
 void ThreatContainer::clearReferences()
 {
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for (ThreatHeap::const_iterator i = iThreatHeap.begin(); i != iThreatHeap.end(); ++i)
     {
         (*i)->unlink();
         delete(*i);
     }
+    iThreatHeap.clear();
+    iThreatByGuid.clear();
     iThreatList.clear();
+    iDirty = false;
 }
 
 //============================================================
-// Return the HostileReference of nullptr, if not found
-HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
+
+void ThreatContainer::addReference(HostileReference* pHostileReference)
 {
-    if (!pVictim)
-        return nullptr;
-    HostileReference* result = nullptr;
-    ObjectGuid guid = pVictim->GetObjectGuid();
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    pHostileReference->iInsertOrder = iInsertCounter++;
+    iThreatHeap.push_back(pHostileReference);
+    placeInHeap(pHostileReference, iThreatHeap.size() - 1);
+    siftUp(pHostileReference->iHeapIndex);
+
+    iThreatByGuid[pHostileReference->getUnitGuid()] = pHostileReference;
+    iThreatList.push_back(pHostileReference);
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    if (!isInHeap(pRef))
+        return;
+
+    size_t index = pRef->iHeapIndex;
+    HostileReference* last = iThreatHeap.back();
+    iThreatHeap.pop_back();
+    if (last != pRef)
     {
-        if ((*i)->getUnitGuid() == guid)
-        {
-            result = (*i);
+        placeInHeap(last, index);
+        siftUp(index);
+        siftDown(last->iHeapIndex);
+    }
+
+    iThreatByGuid.erase(pRef->getUnitGuid());
+    iThreatList.remove(pRef);
+}
+
+//============================================================
+
+void ThreatContainer::update(HostileReference* pRef)
+{
+    if (!isInHeap(pRef))
+        return;
+
+    siftUp(pRef->iHeapIndex);
+    siftDown(pRef->iHeapIndex);
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::siftUp(size_t index)
+{
+    HostileReference* ref = iThreatHeap[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (!IsHigherThreat(ref, iThreatHeap[parent]))
             break;
-        }
+        placeInHeap(iThreatHeap[parent], index);
+        index = parent;
     }
+    placeInHeap(ref, index);
+}
+
+//============================================================
 
-    return result;
+void ThreatContainer::siftDown(size_t index)
+{
+    HostileReference* ref = iThreatHeap[index];
+    size_t size = iThreatHeap.size();
+    while (true)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && IsHigherThreat(iThreatHeap[child + 1], iThreatHeap[child]))
+            ++child;
+        if (!IsHigherThreat(iThreatHeap[child], ref))
+            break;
+        placeInHeap(iThreatHeap[child], index);
+        index = child;
+    }
+    placeInHeap(ref, index);
+}
+
+//============================================================
+// Return the HostileReference of nullptr, if not found
+HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim) const
+{
+    if (!pVictim)
+        return nullptr;
+
+    ThreatGuidMap::const_iterator itr = iThreatByGuid.find(pVictim->GetObjectGuid());
+    return itr != iThreatByGuid.end() ? itr->second : nullptr;
 }
 
 //============================================================
@@ -268,42 +348,83 @@ void ThreatContainer::modifyThreatPercent(Unit* pVictim, int32 pPercent)
 }
 
 //============================================================
+// Sort the list if necessary
 
-bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
+ThreatList const& ThreatContainer::getThreatList() const
 {
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
-    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
+    if (iDirty && iThreatList.size() > 1)
+        iThreatList.sort(ThreatContainer::IsHigherThreat);
+    iDirty = false;
+    return iThreatList;
 }
 
 //============================================================
-// Check if the list is dirty and sort if necessary
+// Visits the heap entries in descending threat order without modifying the heap.
+// Only visited entries and their children are touched, so the common case
+// (most hated reference is still the current victim) does not walk the list.
 
-void ThreatContainer::update()
+class ThreatHeapWalker
 {
-    if (iDirty && iThreatList.size() > 1)
-    {
-        iThreatList.sort(HostileReferenceSortPredicate);
-    }
-    iDirty = false;
-}
+    public:
+        typedef std::vector<HostileReference*> ThreatHeap;
+
+        explicit ThreatHeapWalker(ThreatHeap const& heap) : m_heap(heap) { restart(); }
+
+        bool done() const { return m_frontier.empty(); }
+
+        HostileReference* current() const { return m_heap[m_frontier.front()]; }
+
+        // true if no entry follows the current one
+        bool isLast() const { return m_frontier.size() == 1 && 2 * m_frontier.front() + 1 >= m_heap.size(); }
+
+        void advance()
+        {
+            size_t index = m_frontier.front();
+            std::pop_heap(m_frontier.begin(), m_frontier.end(), Compare(m_heap));
+            m_frontier.pop_back();
+            for (size_t child = 2 * index + 1; child <= 2 * index + 2 && child < m_heap.size(); ++child)
+            {
+                m_frontier.push_back(child);
+                std::push_heap(m_frontier.begin(), m_frontier.end(), Compare(m_heap));
+            }
+        }
+
+        void restart()
+        {
+            m_frontier.clear();
+            if (!m_heap.empty())
+                m_frontier.push_back(0);
+        }
+
+    private:
+        struct Compare
+        {
+            explicit Compare(ThreatHeap const& heap) : heap(heap) {}
+            // std heap functions keep the "largest" element in front
+            bool operator()(size_t lhs, size_t rhs) const { return ThreatContainer::IsHigherThreat(heap[rhs], heap[lhs]); }
+            ThreatHeap const& heap;
+        };
+
+        ThreatHeap const& m_heap;
+        std::vector<size_t> m_frontier;
+};
 
 //============================================================
 // return the next best victim
 // could be the current victim
 
-HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, HostileReference* pCurrentVictim)
+HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, HostileReference* pCurrentVictim) const
 {
     HostileReference* pCurrentRef = nullptr;
     bool found = false;
     bool onlySecondChoiceTargetsFound = false;
     bool checkedCurrentVictim = false;
 
-    ThreatList::const_iterator lastRef = iThreatList.end();
-    --lastRef;
+    ThreatHeapWalker walker(iThreatHeap);
 
-    for (ThreatList::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
+    while (!walker.done())
     {
-        pCurrentRef = (*iter);
+        pCurrentRef = walker.current();
 
         Unit* pTarget = pCurrentRef->getTarget();
         MANGOS_ASSERT(pTarget);                             // if the ref has status online the target must be there!
@@ -313,13 +434,13 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, Hostile
         //     This prevents dropping valid targets due to 1.1 or 1.3 threat rule vs invalid current target
         if (!onlySecondChoiceTargetsFound && pAttacker->IsSecondChoiceTarget(pTarget, false, pCurrentRef == pCurrentVictim))
         {
-            if (iter != lastRef)
-                ++iter;
+            if (!walker.isLast())
+                walker.advance();
             else
             {
                 // if we reached to this point, everyone in the threatlist is a second choice target. In such a situation the target with the highest threat should be attacked.
                 onlySecondChoiceTargetsFound = true;
-                iter = iThreatList.begin();
+                walker.restart();
             }
 
             // current victim is a second choice target, so don't compare threat with it below
@@ -356,7 +477,7 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, Hostile
                     checkedCurrentVictim = true;
                 }
 
-                // list sorted and and we check current target, then this is best case
+                // entries are visited by descending threat and we check current target, then this is best case
                 if (pCurrentRef->getThreat() <= 1.1f * pCurrentVictim->getThreat())
                 {
                     pCurrentRef = pCurrentVictim;
@@ -378,7 +499,7 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, Hostile
                 break;
             }
         }
-        ++iter;
+        walker.advance();
     }
     if (!found)
         pCurrentRef = nullptr;
@@ -473,7 +594,6 @@ void ThreatManager::modifyThreatPercent(Unit* pVictim, int32 pPercent)
 
 Unit* ThreatManager::getHostileTarget()
 {
-    iThreatContainer.update();
     HostileReference* nextVictim = iThreatContainer.selectNextVictim((Creature*) getOwner(), getCurrentVictim());
     setCurrentVictim(nextVictim);
     return getCurrentVictim() != nullptr ? getCurrentVictim()->getTarget() : nullptr;
@@ -543,35 +663,29 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostileReference && threatRefStatusChangeEvent->getFValue() < 0.0f) ||
-                    (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent->getFValue() > 0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // the order in the threat list might have changed
+            if (hostileReference->isOnline())
+                iThreatContainer.update(hostileReference);
+            else
+                iThreatOfflineContainer.update(hostileReference);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostileReference->isOnline())
             {
                 if (hostileReference == getCurrentVictim())
-                {
                     setCurrentVictim(nullptr);
-                    setDirty(true);
-                }
                 iThreatContainer.remove(hostileReference);
                 iThreatOfflineContainer.addReference(hostileReference);
             }
             else
             {
-                if (getCurrentVictim() && hostileReference->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
-                    setDirty(true);
-                iThreatContainer.addReference(hostileReference);
                 iThreatOfflineContainer.remove(hostileReference);
+                iThreatContainer.addReference(hostileReference);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
             if (hostileReference == getCurrentVictim())
-            {
                 setCurrentVictim(nullptr);
-                setDirty(true);
-            }
             if (hostileReference->isOnline())
             {
                 iThreatContainer.remove(hostileReference);
@@ -25,6 +25,7 @@
 #include "Entities/UnitEvents.h"
 #include "Entities/ObjectGuid.h"
 #include <list>
+#include <vector>
 
 //==============================================================
 
@@ -121,11 +122,15 @@ class HostileReference : public Reference<Unit, ThreatManager>
 
         Unit* getSourceUnit() const;
     private:
+        friend class ThreatContainer;
+
         float iThreat;
         float iTempThreatModifyer;                          // used for taunt
         ObjectGuid iUnitGuid;
         bool iOnline;
         bool iAccessible;
+        size_t iHeapIndex;                                  // position in the threat heap of the owning container
+        uint32 iInsertOrder;                                // equal threat is ordered by insertion into the container
 };
 
 //==============================================================
@@ -134,40 +139,62 @@ class ThreatManager;
 typedef std::list<HostileReference*> ThreatList;
 
 
+// Threat references are kept in an indexed binary max-heap ordered by threat,
+// so a threat change costs O(log n) and the most hated reference is always on top.
+// The sorted ThreatList handed out to scripts is only re-sorted on request.
 class ThreatContainer
 {
     private:
-        ThreatList iThreatList;
-        bool iDirty;
+        typedef std::vector<HostileReference*> ThreatHeap;
+        typedef std::unordered_map<ObjectGuid, HostileReference*> ThreatGuidMap;
+
+        ThreatHeap iThreatHeap;
+        ThreatGuidMap iThreatByGuid;
+        mutable ThreatList iThreatList;
+        mutable bool iDirty;
+        uint32 iInsertCounter;
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
-        void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
+        void remove(HostileReference* pRef);
+        void addReference(HostileReference* pHostileReference);
         void clearReferences();
-        // Sort the list if necessary
-        void update();
+        // Restore the heap order after the threat of the reference was changed
+        void update(HostileReference* pRef);
     public:
-        ThreatContainer() { iDirty = false; }
+        ThreatContainer() : iDirty(false), iInsertCounter(0) {}
         ~ThreatContainer() { clearReferences(); }
 
         HostileReference* addThreat(Unit* pVictim, float pThreat);
 
         void modifyThreatPercent(Unit* pVictim, int32 percent);
 
-        HostileReference* selectNextVictim(Creature* pAttacker, HostileReference* pCurrentVictim);
+        HostileReference* selectNextVictim(Creature* pAttacker, HostileReference* pCurrentVictim) const;
 
         void setDirty(bool pDirty) { iDirty = pDirty; }
 
         bool isDirty() const { return iDirty; }
 
-        bool empty() const { return iThreatList.empty(); }
+        bool empty() const { return iThreatHeap.empty(); }
+
+        HostileReference* getMostHated() const { return iThreatHeap.empty() ? nullptr : iThreatHeap.front(); }
 
-        HostileReference* getMostHated() { return iThreatList.empty() ? nullptr : iThreatList.front(); }
+        HostileReference* getReferenceByTarget(Unit* pVictim) const;
 
-        HostileReference* getReferenceByTarget(Unit* pVictim);
+        ThreatList const& getThreatList() const;
 
-        ThreatList const& getThreatList() const { return iThreatList; }
+        // Heap ordering predicate: higher threat first, then older reference first
+        static bool IsHigherThreat(HostileReference const* lhs, HostileReference const* rhs)
+        {
+            if (lhs->iThreat != rhs->iThreat)
+                return lhs->iThreat > rhs->iThreat;
+            return lhs->iInsertOrder < rhs->iInsertOrder;
+        }
+    private:
+        bool isInHeap(HostileReference const* pRef) const { return pRef->iHeapIndex < iThreatHeap.size() && iThreatHeap[pRef->iHeapIndex] == pRef; }
+        void placeInHeap(HostileReference* pRef, size_t index) { iThreatHeap[index] = pRef; pRef->iHeapIndex = index; }
+        void siftUp(size_t index);
+        void siftDown(size_t index);
 };
 
 //=================================================
@@ -132,16 +132,16 @@ void Camera::UpdateVisibilityOf(WorldObject* target) const
 }
 
 template<class T>
-void Camera::UpdateVisibilityOf(T* target, UpdateData& data, std::set<WorldObject*>& vis)
+void Camera::UpdateVisibilityOf(T* target, UpdateData& data, std::vector<WorldObject*>& vis)
 {
     m_owner.template UpdateVisibilityOf<T>(m_source, target, data, vis);
 }
 
-template void Camera::UpdateVisibilityOf(Player*, UpdateData&, std::set<WorldObject*>&);
-template void Camera::UpdateVisibilityOf(Creature*, UpdateData&, std::set<WorldObject*>&);
-template void Camera::UpdateVisibilityOf(Corpse*, UpdateData&, std::set<WorldObject*>&);
-template void Camera::UpdateVisibilityOf(GameObject*, UpdateData&, std::set<WorldObject*>&);
-template void Camera::UpdateVisibilityOf(DynamicObject*, UpdateData&, std::set<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(Player*, UpdateData&, std::vector<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(Creature*, UpdateData&, std::vector<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(Corpse*, UpdateData&, std::vector<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(GameObject*, UpdateData&, std::vector<WorldObject*>&);
+template void Camera::UpdateVisibilityOf(DynamicObject*, UpdateData&, std::vector<WorldObject*>&);
 
 void Camera::UpdateVisibilityForOwner()
 {
@@ -49,7 +49,7 @@ class Camera
         void ResetView(bool update_far_sight_field = true);
 
         template<class T>
-        void UpdateVisibilityOf(T* obj, UpdateData& d, std::set<WorldObject*>& vis);
+        void UpdateVisibilityOf(T* obj, UpdateData& d, std::vector<WorldObject*>& vis);
         void UpdateVisibilityOf(WorldObject* obj) const;
 
         void ReceivePacket(WorldPacket const& data) const;
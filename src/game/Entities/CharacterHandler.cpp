@@ -35,6 +35,7 @@
 #include "Database/DatabaseImpl.h"
 #include "Tools/PlayerDump.h"
 #include "Social/SocialMgr.h"
+#include "Social/PlayerDirectory.h"
 #include "Util.h"
 #include "Tools/Language.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
@@ -617,6 +618,9 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
     }
 
     sObjectAccessor.AddObject(pCurrChar);
+    sPlayerDirectory.AddPlayer(pCurrChar);
+    if (Guild* guild = sGuildMgr.GetGuildById(pCurrChar->GetGuildId()))
+        guild->AddOnlineMember(pCurrChar);
     // DEBUG_LOG("Player %s added to Map.",pCurrChar->GetName());
     pCurrChar->GetSocial()->SendSocialList();
 
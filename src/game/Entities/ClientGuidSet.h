@@ -0,0 +1,212 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_CLIENTGUIDSET_H
+#define MANGOS_CLIENTGUIDSET_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+#include "Errors.h"
+
+#include <vector>
+
+/**
+ * Guids of the objects known by a player's client (Player::m_clientGUIDs).
+ *
+ * Open addressing hash set with linear probing, kept at most half full. Every entry carries
+ * the stamp of the last visibility pass that saw it, so MaNGOS::VisibleNotifier finds the
+ * objects that left the view without copying the set. Entries are removed by backward
+ * shifting, the set must not be modified while it is iterated.
+ */
+class ClientGuidSet
+{
+    private:
+        struct Slot
+        {
+            Slot() : stamp(0) {}
+
+            ObjectGuid guid;                                // empty guid marks a free slot
+            uint32 stamp;                                   // last visibility pass that saw the object
+        };
+
+        typedef std::vector<Slot> SlotVector;
+
+    public:
+        class const_iterator
+        {
+            public:
+                const_iterator(SlotVector const& slots, size_t pos) : m_slots(&slots), m_pos(pos) { SkipFree(); }
+
+                ObjectGuid const& operator*() const { return (*m_slots)[m_pos].guid; }
+                ObjectGuid const* operator->() const { return &(*m_slots)[m_pos].guid; }
+
+                const_iterator& operator++() { ++m_pos; SkipFree(); return *this; }
+
+                bool operator==(const_iterator const& other) const { return m_pos == other.m_pos; }
+                bool operator!=(const_iterator const& other) const { return m_pos != other.m_pos; }
+
+            private:
+                void SkipFree()
+                {
+                    while (m_pos < m_slots->size() && (*m_slots)[m_pos].guid.IsEmpty())
+                        ++m_pos;
+                }
+
+                SlotVector const* m_slots;
+                size_t m_pos;
+        };
+
+        ClientGuidSet() : m_size(0), m_stamp(1) {}
+
+        const_iterator begin() const { return const_iterator(m_slots, 0); }
+        const_iterator end() const { return const_iterator(m_slots, m_slots.size()); }
+
+        bool empty() const { return m_size == 0; }
+        size_t size() const { return m_size; }
+
+        size_t count(ObjectGuid const& guid) const { return FindSlot(guid) != m_slots.size() ? 1 : 0; }
+
+        // new entries count as seen by the running visibility pass
+        bool insert(ObjectGuid const& guid)
+        {
+            MANGOS_ASSERT(!guid.IsEmpty());
+
+            if ((m_size + 1) * 2 > m_slots.size())
+                Rehash(m_slots.empty() ? 64 : m_slots.size() * 2);
+
+            size_t mask = m_slots.size() - 1;
+            for (size_t i = Hash(guid) & mask;; i = (i + 1) & mask)
+            {
+                Slot& slot = m_slots[i];
+                if (slot.guid == guid)
+                    return false;
+
+                if (slot.guid.IsEmpty())
+                {
+                    slot.guid = guid;
+                    slot.stamp = m_stamp;
+                    ++m_size;
+                    return true;
+                }
+            }
+        }
+
+        size_t erase(ObjectGuid const& guid)
+        {
+            size_t pos = FindSlot(guid);
+            if (pos == m_slots.size())
+                return 0;
+
+            // shift following entries of the probe run back, no tombstones needed
+            size_t mask = m_slots.size() - 1;
+            for (size_t next = (pos + 1) & mask; !m_slots[next].guid.IsEmpty(); next = (next + 1) & mask)
+            {
+                size_t home = Hash(m_slots[next].guid) & mask;
+                if (((next - home) & mask) >= ((next - pos) & mask))
+                {
+                    m_slots[pos] = m_slots[next];
+                    pos = next;
+                }
+            }
+
+            m_slots[pos] = Slot();
+            --m_size;
+            return 1;
+        }
+
+        void clear()
+        {
+            m_slots.clear();
+            m_size = 0;
+        }
+
+        /// Starts a visibility pass, returns its stamp for CollectUnseen
+        uint32 BeginPass() { return ++m_stamp; }
+
+        /// Marks the object as seen by the running pass
+        void Touch(ObjectGuid const& guid)
+        {
+            size_t pos = FindSlot(guid);
+            if (pos != m_slots.size())
+                m_slots[pos].stamp = m_stamp;
+        }
+
+        bool IsSeenSince(ObjectGuid const& guid, uint32 passStamp) const
+        {
+            size_t pos = FindSlot(guid);
+            return pos == m_slots.size() || IsStampSince(m_slots[pos].stamp, passStamp);
+        }
+
+        /// Collects the objects not seen by the pass started with passStamp or by any pass nested into it
+        void CollectUnseen(uint32 passStamp, GuidVector& unseen) const
+        {
+            for (SlotVector::const_iterator itr = m_slots.begin(); itr != m_slots.end(); ++itr)
+                if (!itr->guid.IsEmpty() && !IsStampSince(itr->stamp, passStamp))
+                    unseen.push_back(itr->guid);
+        }
+
+    private:
+        static bool IsStampSince(uint32 stamp, uint32 passStamp) { return int32(stamp - passStamp) >= 0; }
+
+        static size_t Hash(ObjectGuid const& guid)
+        {
+            uint64 h = guid.GetRawValue() * uint64(0x9E3779B97F4A7C15ULL);
+            return size_t(h ^ (h >> 32));
+        }
+
+        size_t FindSlot(ObjectGuid const& guid) const
+        {
+            if (m_slots.empty() || guid.IsEmpty())
+                return m_slots.size();
+
+            size_t mask = m_slots.size() - 1;
+            for (size_t i = Hash(guid) & mask;; i = (i + 1) & mask)
+            {
+                if (m_slots[i].guid == guid)
+                    return i;
+
+                if (m_slots[i].guid.IsEmpty())
+                    return m_slots.size();
+            }
+        }
+
+        void Rehash(size_t capacity)
+        {
+            SlotVector old;
+            old.swap(m_slots);
+            m_slots.resize(capacity);
+
+            size_t mask = capacity - 1;
+            for (SlotVector::const_iterator itr = old.begin(); itr != old.end(); ++itr)
+            {
+                if (itr->guid.IsEmpty())
+                    continue;
+
+                size_t i = Hash(itr->guid) & mask;
+                while (!m_slots[i].guid.IsEmpty())
+                    i = (i + 1) & mask;
+                m_slots[i] = *itr;
+            }
+        }
+
+        SlotVector m_slots;
+        size_t m_size;
+        uint32 m_stamp;
+};
+
+#endif
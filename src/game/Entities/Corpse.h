@@ -23,6 +23,7 @@
 #include "Entities/Object.h"
 #include "Database/DatabaseEnv.h"
 #include "Maps/GridDefines.h"
+#include "Utilities/ObjectPool.h"
 
 enum CorpseType
 {
@@ -52,6 +53,9 @@ class Corpse : public WorldObject
         explicit Corpse(CorpseType type = CORPSE_BONES);
         ~Corpse();
 
+        static void* operator new(size_t size) { return MaNGOS::ObjectPool<Corpse>::Instance().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { MaNGOS::ObjectPool<Corpse>::Instance().Deallocate(ptr, size); }
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
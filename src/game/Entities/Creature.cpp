@@ -517,6 +517,8 @@ uint32 Creature::ChooseDisplayId(const CreatureInfo* cinfo, const CreatureData*
 
 void Creature::Update(uint32 update_diff, uint32 diff)
 {
+    ProfileScope profileScope("creature", GetEntry());
+
     switch (m_deathState)
     {
         case JUST_ALIVED:
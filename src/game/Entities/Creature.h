@@ -24,7 +24,9 @@
 #include "Globals/SharedDefines.h"
 #include "Server/DBCEnums.h"
 #include "Grids/Cell.h"
+#include "Grids/IndexedGridReference.h"
 #include "Util.h"
+#include "Utilities/ObjectPool.h"
 
 #include <list>
 #include <memory>
@@ -502,6 +504,10 @@ class Creature : public Unit
         explicit Creature(CreatureSubtype subtype = CREATURE_SUBTYPE_GENERIC);
         virtual ~Creature();
 
+        // grid load/unload churn is served from a type specific slab pool
+        static void* operator new(size_t size) { return MaNGOS::ObjectPool<Creature>::Instance().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { MaNGOS::ObjectPool<Creature>::Instance().Deallocate(ptr, size); }
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
         void CleanupsBeforeDelete() override;
@@ -718,7 +724,7 @@ class Creature : public Unit
         bool HasQuest(uint32 quest_id) const override;
         bool HasInvolvedQuest(uint32 quest_id)  const override;
 
-        GridReference<Creature>& GetGridRef() { return m_gridRef; }
+        IndexedGridReference<Creature>& GetGridRef() { return m_gridRef; }
         bool IsRegeneratingHealth() { return !!(GetCreatureInfo()->RegenerateStats & REGEN_FLAG_HEALTH); }
         bool IsRegeneratingPower() { return !!(GetCreatureInfo()->RegenerateStats & REGEN_FLAG_POWER); }
         virtual uint8 GetPetAutoSpellSize() const { return CREATURE_MAX_SPELLS; }
@@ -798,7 +804,7 @@ class Creature : public Unit
         uint32 m_gameEventVendorId;                        // game event creature data vendor id override
 
     private:
-        GridReference<Creature> m_gridRef;
+        IndexedGridReference<Creature> m_gridRef;
         CreatureInfo const* m_creatureInfo;                 // in heroic mode can different from sObjectMgr::GetCreatureTemplate(GetEntry())
 };
 
@@ -22,6 +22,7 @@
 #include "Entities/Object.h"
 #include "Server/DBCEnums.h"
 #include "Entities/Unit.h"
+#include "Utilities/ObjectPool.h"
 
 enum DynamicObjectType
 {
@@ -37,6 +38,9 @@ class DynamicObject : public WorldObject
     public:
         explicit DynamicObject();
 
+        static void* operator new(size_t size) { return MaNGOS::ObjectPool<DynamicObject>::Instance().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { MaNGOS::ObjectPool<DynamicObject>::Instance().Deallocate(ptr, size); }
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
@@ -39,6 +39,7 @@
 #include "Util.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "vmap/GameObjectModel.h"
+#include "MotionGenerators/PathCorridorCache.h"
 #include "Server/SQLStorages.h"
 
 GameObject::GameObject() : WorldObject(),
@@ -1833,6 +1834,7 @@ void GameObject::UpdateCollisionState() const
         return;
 
     m_model->enable(IsCollisionEnabled() ? true : false);
+    GetMap()->GetPathCorridorCache()->Invalidate();
 }
 
 void GameObject::UpdateModel()
@@ -23,6 +23,7 @@
 #include "Globals/SharedDefines.h"
 #include "Entities/Object.h"
 #include "Util.h"
+#include "Utilities/ObjectPool.h"
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -590,6 +591,9 @@ class GameObject : public WorldObject
         explicit GameObject();
         ~GameObject();
 
+        static void* operator new(size_t size) { return MaNGOS::ObjectPool<GameObject>::Instance().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { MaNGOS::ObjectPool<GameObject>::Instance().Deallocate(ptr, size); }
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
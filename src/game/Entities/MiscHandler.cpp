@@ -38,6 +38,7 @@
 #include "OutdoorPvP/OutdoorPvP.h"
 #include "Entities/Pet.h"
 #include "Social/SocialMgr.h"
+#include "Social/PlayerDirectory.h"
 
 void WorldSession::HandleRepopRequestOpcode(WorldPacket& recv_data)
 {
@@ -70,193 +71,91 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recv_data)
     DEBUG_LOG("WORLD: Received opcode CMSG_WHO");
     // recv_data.hexlike();
 
-    uint32 level_min, level_max, racemask, classmask, zones_count, str_count;
-    uint32 zoneids[10];                                     // 10 is client limit
+    WhoListQuery query;
+    uint32 zones_count, str_count;
     std::string player_name, guild_name;
 
-    recv_data >> level_min;                                 // maximal player level, default 0
-    recv_data >> level_max;                                 // minimal player level, default 100 (MAX_LEVEL)
+    recv_data >> query.levelMin;                            // maximal player level, default 0
+    recv_data >> query.levelMax;                            // minimal player level, default 100 (MAX_LEVEL)
     recv_data >> player_name;                               // player name, case sensitive...
 
     recv_data >> guild_name;                                // guild name, case sensitive...
 
-    recv_data >> racemask;                                  // race mask
-    recv_data >> classmask;                                 // class mask
+    recv_data >> query.raceMask;                            // race mask
+    recv_data >> query.classMask;                           // class mask
     recv_data >> zones_count;                               // zones count, client limit=10 (2.0.10)
 
-    if (zones_count > 10)
+    if (zones_count > WHO_LIST_MAX_ZONES)
         return;                                             // can't be received from real client or broken packet
 
     for (uint32 i = 0; i < zones_count; ++i)
     {
         uint32 temp;
         recv_data >> temp;                                  // zone id, 0 if zone is unknown...
-        zoneids[i] = temp;
-        DEBUG_LOG("Zone %u: %u", i, zoneids[i]);
+        query.zoneIds[i] = temp;
+        DEBUG_LOG("Zone %u: %u", i, query.zoneIds[i]);
     }
+    query.zonesCount = zones_count;
 
     recv_data >> str_count;                                 // user entered strings count, client limit=4 (checked on 2.0.10)
 
-    if (str_count > 4)
+    if (str_count > WHO_LIST_MAX_STRINGS)
         return;                                             // can't be received from real client or broken packet
 
-    DEBUG_LOG("Minlvl %u, maxlvl %u, name %s, guild %s, racemask %u, classmask %u, zones %u, strings %u", level_min, level_max, player_name.c_str(), guild_name.c_str(), racemask, classmask, zones_count, str_count);
+    DEBUG_LOG("Minlvl %u, maxlvl %u, name %s, guild %s, racemask %u, classmask %u, zones %u, strings %u", query.levelMin, query.levelMax, player_name.c_str(), guild_name.c_str(), query.raceMask, query.classMask, zones_count, str_count);
 
-    std::wstring str[4];                                    // 4 is client limit
     for (uint32 i = 0; i < str_count; ++i)
     {
         std::string temp;
         recv_data >> temp;                                  // user entered string, it used as universal search pattern(guild+player name)?
 
-        if (!Utf8toWStr(temp, str[i]))
+        if (!Utf8toWStr(temp, query.strings[i]))
             continue;
 
-        wstrToLower(str[i]);
+        wstrToLower(query.strings[i]);
 
         DEBUG_LOG("String %u: %s", i, temp.c_str());
     }
+    query.stringsCount = str_count;
 
-    std::wstring wplayer_name;
-    std::wstring wguild_name;
-    if (!(Utf8toWStr(player_name, wplayer_name) && Utf8toWStr(guild_name, wguild_name)))
+    if (!(Utf8toWStr(player_name, query.playerName) && Utf8toWStr(guild_name, query.guildName)))
         return;
-    wstrToLower(wplayer_name);
-    wstrToLower(wguild_name);
+    wstrToLower(query.playerName);
+    wstrToLower(query.guildName);
 
     // client send in case not set max level value 100 but mangos support 255 max level,
     // update it to show GMs with characters after 100 level
-    if (level_max >= MAX_LEVEL)
-        level_max = STRONG_MAX_LEVEL;
+    if (query.levelMax >= MAX_LEVEL)
+        query.levelMax = STRONG_MAX_LEVEL;
 
-    Team team = _player->GetTeam();
-    AccountTypes security = GetSecurity();
-    bool allowTwoSideWhoList = sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST);
-    AccountTypes gmLevelInWhoList = (AccountTypes)sWorld.getConfig(CONFIG_GM_LEVEL_IN_WHO_LIST);
+    query.searcher = _player;
+    query.locale = GetSessionDbcLocale();
+    query.checkSecurity = GetSecurity() == SEC_PLAYER;
+    query.allowTwoSide = sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST);
+    query.gmLevelInList = sWorld.getConfig(CONFIG_GM_LEVEL_IN_WHO_LIST);
 
-    uint32 matchcount = 0;
-    uint32 displaycount = 0;
-
-    WorldPacket data(SMSG_WHO, 50);                         // guess size
-    data << uint32(matchcount);                             // placeholder, count of players matching criteria
-    data << uint32(displaycount);                           // placeholder, count of players displayed
-
-    // TODO: Guard Player map
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        Player* pl = itr->second;
-
-        if (security == SEC_PLAYER)
-        {
-            // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
-            if (pl->GetTeam() != team && !allowTwoSideWhoList)
-                continue;
-
-            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
-            if (pl->GetSession()->GetSecurity() > gmLevelInWhoList)
-                continue;
-        }
-
-        // do not process players which are not in world
-        if (!pl->IsInWorld())
-            continue;
-
-        // check if target is globally visible for player
-        if (!pl->IsVisibleGloballyFor(_player))
-            continue;
-
-        // check if target's level is in level range
-        uint32 lvl = pl->getLevel();
-        if (lvl < level_min || lvl > level_max)
-            continue;
-
-        // check if class matches classmask
-        uint32 class_ = pl->getClass();
-        if (!(classmask & (1 << class_)))
-            continue;
-
-        // check if race matches racemask
-        uint32 race = pl->getRace();
-        if (!(racemask & (1 << race)))
-            continue;
-
-        uint32 pzoneid = pl->GetZoneId();
-        uint8 gender = pl->getGender();
-
-        bool z_show = true;
-        for (uint32 i = 0; i < zones_count; ++i)
-        {
-            if (zoneids[i] == pzoneid)
-            {
-                z_show = true;
-                break;
-            }
-
-            z_show = false;
-        }
-        if (!z_show)
-            continue;
-
-        std::string pname = pl->GetName();
-        std::wstring wpname;
-        if (!Utf8toWStr(pname, wpname))
-            continue;
-        wstrToLower(wpname);
-
-        if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
-            continue;
-
-        std::string gname = sGuildMgr.GetGuildNameById(pl->GetGuildId());
-        std::wstring wgname;
-        if (!Utf8toWStr(gname, wgname))
-            continue;
-        wstrToLower(wgname);
-
-        if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
-            continue;
-
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(pzoneid))
-            aname = areaEntry->area_name[GetSessionDbcLocale()];
-
-        bool s_show = true;
-        for (uint32 i = 0; i < str_count; ++i)
-        {
-            if (!str[i].empty())
-            {
-                if (wgname.find(str[i]) != std::wstring::npos ||
-                        wpname.find(str[i]) != std::wstring::npos ||
-                        Utf8FitTo(aname, str[i]))
-                {
-                    s_show = true;
-                    break;
-                }
-                s_show = false;
-            }
-        }
-        if (!s_show)
-            continue;
-
-        // 49 is maximum player count sent to client
-        if (++matchcount > 49)
-            continue;
-
-        ++displaycount;
-
-        data << pname;                                      // player name
-        data << gname;                                      // guild name
-        data << uint32(lvl);                                // player level
-        data << uint32(class_);                             // player class
-        data << uint32(race);                               // player race
-        data << uint8(gender);                              // player gender
-        data << uint32(pzoneid);                            // player zone id
-    }
+    // 49 is maximum player count sent to client
+    std::vector<WhoListMatch> matches;
+    uint32 matchcount = sPlayerDirectory.SearchWhoList(query, 49, matches);
+    uint32 displaycount = uint32(matches.size());
 
     if (sWorld.getConfig(CONFIG_MAX_WHOLIST_RETURNS) && matchcount > sWorld.getConfig(CONFIG_MAX_WHOLIST_RETURNS))
         matchcount = sWorld.getConfig(CONFIG_MAX_WHOLIST_RETURNS);
 
-    data.put(0, displaycount);                              // insert right count, count displayed
-    data.put(4, matchcount);                                // insert right count, count of matches
+    WorldPacket data(SMSG_WHO, 8 + displaycount * 40);      // guess size
+    data << uint32(displaycount);                           // count of players displayed
+    data << uint32(matchcount);                             // count of players matching criteria
+
+    for (std::vector<WhoListMatch>::const_iterator itr = matches.begin(); itr != matches.end(); ++itr)
+    {
+        data << itr->name;                                  // player name
+        data << itr->guildName;                             // guild name
+        data << uint32(itr->level);                         // player level
+        data << uint32(itr->class_);                        // player class
+        data << uint32(itr->race);                          // player race
+        data << uint8(itr->gender);                         // player gender
+        data << uint32(itr->zoneId);                        // player zone id
+    }
 
     SendPacket(data);
     DEBUG_LOG("WORLD: Send SMSG_WHO Message");
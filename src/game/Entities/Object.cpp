@@ -78,7 +78,7 @@ void Object::_InitValues()
     m_uint32Values = new uint32[ m_valuesCount ];
     memset(m_uint32Values, 0, m_valuesCount * sizeof(uint32));
 
-    m_changedValues.resize(m_valuesCount, false);
+    m_changedValues.resize((m_valuesCount + 31) / 32, 0);
 
     m_objectUpdated = false;
 }
@@ -120,14 +120,12 @@ void Object::SendForcedObjectUpdate()
 
 void Object::BuildMovementUpdateBlock(UpdateData* data, uint8 flags) const
 {
-    ByteBuffer buf(500);
+    ByteBuffer& buf = data->AddUpdateBlock();
 
     buf << uint8(UPDATETYPE_MOVEMENT);
     buf << GetObjectGuid();
 
     BuildMovementUpdate(&buf, flags);
-
-    data->AddUpdateBlock(buf);
 }
 
 void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) const
@@ -167,7 +165,7 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
 
     // DEBUG_LOG("BuildCreateUpdate: update-type: %u, object-type: %u got updateFlags: %X", updatetype, m_objectTypeId, updateFlags);
 
-    ByteBuffer buf(500);
+    ByteBuffer& buf = data->AddUpdateBlock();
     buf << uint8(updatetype);
     buf << GetPackGUID();
     buf << uint8(m_objectTypeId);
@@ -178,7 +176,6 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
     updateMask.SetCount(m_valuesCount);
     _SetCreateBits(&updateMask, target);
     BuildValuesUpdate(updatetype, &buf, &updateMask, target);
-    data->AddUpdateBlock(buf);
 }
 
 void Object::SendCreateUpdateToPlayer(Player* player) const
@@ -194,7 +191,7 @@ void Object::SendCreateUpdateToPlayer(Player* player) const
 
 void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
 {
-    ByteBuffer buf(500);
+    ByteBuffer& buf = data->AddUpdateBlock();
 
     buf << uint8(UPDATETYPE_VALUES);
     buf << GetPackGUID();
@@ -204,8 +201,6 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
 
     _SetUpdateBits(&updateMask, target);
     BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
-
-    data->AddUpdateBlock(buf);
 }
 
 void Object::BuildOutOfRangeUpdateBlock(UpdateData* data) const
@@ -391,223 +386,215 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
     MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
 
     *data << (uint8)updateMask->GetBlockCount();
-    data->append(updateMask->GetMask(), updateMask->GetLength());
+    for (uint32 block = 0; block < updateMask->GetBlockCount(); ++block)
+        *data << updateMask->GetBlock(block);
 
     // 2 specialized loops for speed optimization in non-unit case
     if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->FindNextSetBit(0); index < m_valuesCount; index = updateMask->FindNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (index == UNIT_NPC_FLAGS)
             {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
+                uint32 appendValue = m_uint32Values[index];
 
-                    if (GetTypeId() == TYPEID_UNIT)
+                if (GetTypeId() == TYPEID_UNIT)
+                {
+                    if (appendValue & UNIT_NPC_FLAG_TRAINER)
                     {
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                        }
+                        if (!((Creature*)this)->IsTrainerOf(target, false))
+                            appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
+                    }
 
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
-                        
-                        if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                    if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
+                    {
+                        if (target->getClass() != CLASS_HUNTER)
+                            appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
+                    }
+                    
+                    if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                    {
+                        QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
+                        for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                         {
-                            QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                            Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                            if (target->CanSeeStartQuest(pQuest))
                             {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanSeeStartQuest(pQuest))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
+                                appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                                break;
                             }
+                        }
 
-                            bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                        bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
+                        for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                        {
+                            Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                            if (target->CanRewardQuest(pQuest, false))
                             {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanRewardQuest(pQuest, false))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
+                                appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                                break;
                             }
                         }
                     }
-
-                    *data << uint32(appendValue);
                 }
-                else if (index == UNIT_FIELD_AURASTATE)
+
+                *data << uint32(appendValue);
+            }
+            else if (index == UNIT_FIELD_AURASTATE)
+            {
+                if (IsPerCasterAuraState)
                 {
-                    if (IsPerCasterAuraState)
-                    {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
-                            *data << m_uint32Values[index];
-                        else
-                            *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
-                    }
-                    else
+                    // IsPerCasterAuraState set if related pet caster aura state set already
+                    if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
                         *data << m_uint32Values[index];
+                    else
+                        *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
                 }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-                }
+                else
+                    *data << m_uint32Values[index];
+            }
+            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+            {
+                // convert from float to uint32 and send
+                *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+            }
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[index]);
-                }
+            // there are some float values which may be negative or can't get negative due to other checks
+            else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
+                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                     (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+            {
+                *data << uint32(m_floatValues[index]);
+            }
 
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
-                {
-                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
-                }
-                // Hide lootable animation for unallowed players
-                // Handle tapped flag
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+            // Gamemasters should be always able to select units - remove not selectable flag
+            else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
+            {
+                *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
+            }
+            // Hide lootable animation for unallowed players
+            // Handle tapped flag
+            else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+            {
+                Creature* creature = (Creature*)this;
+                uint32 dynflagsValue = m_uint32Values[index];
+                bool setTapFlags = false;
+
+                if (creature->isAlive())
                 {
-                    Creature* creature = (Creature*)this;
-                    uint32 dynflagsValue = m_uint32Values[index];
-                    bool setTapFlags = false;
+                    // creature is alive so, not lootable
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
 
-                    if (creature->isAlive())
+                    if (creature->isInCombat())
                     {
-                        // creature is alive so, not lootable
-                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-
-                        if (creature->isInCombat())
-                        {
-                            // as creature is in combat we have to manage tap flags
-                            setTapFlags = true;
-                        }
-                        else
-                        {
-                            // creature is not in combat so its not tapped
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
+                        // as creature is in combat we have to manage tap flags
+                        setTapFlags = true;
                     }
                     else
                     {
-                        // check loot flag
-                        if (creature->loot && creature->loot->CanLoot(target))
-                        {
-                            // creature is dead and this player can loot it
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
-                        else
-                        {
-                            // creature is dead but this player cannot loot it
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is not lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
-
-                        // as creature is died we have to manage tap flags
-                        setTapFlags = true;
+                        // creature is not in combat so its not tapped
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                        //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
                     }
-
-                    // check tap flags
-                    if (setTapFlags)
+                }
+                else
+                {
+                    // check loot flag
+                    if (creature->loot && creature->loot->CanLoot(target))
                     {
-                        if (creature->IsTappedBy(target))
-                        {
-                            // creature is in combat or died and tapped by this player
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
-                        else
-                        {
-                            // creature is in combat or died but not tapped by this player
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
+                        // creature is dead and this player can loot it
+                        dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
+                        //sLog.outString(">> %s is lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                    }
+                    else
+                    {
+                        // creature is dead but this player cannot loot it
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+                        //sLog.outString(">> %s is not lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
                     }
 
-                    *data << dynflagsValue;
+                    // as creature is died we have to manage tap flags
+                    setTapFlags = true;
                 }
-                else                                        // Unhandled index, just send
+
+                // check tap flags
+                if (setTapFlags)
                 {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
+                    if (creature->IsTappedBy(target))
+                    {
+                        // creature is in combat or died and tapped by this player
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                        //sLog.outString(">> %s is tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                    }
+                    else
+                    {
+                        // creature is in combat or died but not tapped by this player
+                        dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
+                        //sLog.outString(">> %s is not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                    }
                 }
+
+                *data << dynflagsValue;
+            }
+            else                                        // Unhandled index, just send
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
             }
         }
     }
     else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->FindNextSetBit(0); index < m_valuesCount; index = updateMask->FindNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            // send in current format (float as float, uint32 as uint32)
+            if (index == GAMEOBJECT_DYN_FLAGS)
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYN_FLAGS)
-                {
-                    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
-                    //      most likely related to "can enter map" and then should be 0 if can not enter
+                // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
+                //      most likely related to "can enter map" and then should be 0 if can not enter
 
-                    if (IsActivateToQuest)
+                if (IsActivateToQuest)
+                {
+                    GameObject const* gameObject = static_cast<GameObject const*>(this);
+                    switch (((GameObject*)this)->GetGoType())
                     {
-                        GameObject const* gameObject = static_cast<GameObject const*>(this);
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                                if (gameObject->getLootState() == GO_READY || gameObject->getLootState() == GO_ACTIVATED)
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                else
-                                    *data << uint16(0);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
+                        case GAMEOBJECT_TYPE_QUESTGIVER:
+                            *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
+                            *data << uint16(0);
+                            break;
+                        case GAMEOBJECT_TYPE_CHEST:
+                            if (gameObject->getLootState() == GO_READY || gameObject->getLootState() == GO_ACTIVATED)
                                 *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            else
                                 *data << uint16(0);
-                                break;
-                            default:
-                                *data << uint32(0);         // unknown, not happen.
-                                break;
-                        }
+                            *data << uint16(0);
+                            break;
+                        case GAMEOBJECT_TYPE_GENERIC:
+                        case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                        case GAMEOBJECT_TYPE_GOOBER:
+                            *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            *data << uint16(0);
+                            break;
+                        default:
+                            *data << uint32(0);         // unknown, not happen.
+                            break;
                     }
-                    else
-                        *data << uint32(0);                 // disable quest object
                 }
                 else
-                    *data << m_uint32Values[index];         // other cases
+                    *data << uint32(0);                 // disable quest object
             }
+            else
+                *data << m_uint32Values[index];         // other cases
         }
     }
     else                                                    // other objects case (no special index checks)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->FindNextSetBit(0); index < m_valuesCount; index = updateMask->FindNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
-            {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
-            }
+            // send in current format (float as float, uint32 as uint32)
+            *data << m_uint32Values[index];
         }
     }
 }
@@ -615,10 +602,7 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
 void Object::ClearUpdateMask(bool remove)
 {
     if (m_uint32Values)
-    {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-            m_changedValues[index] = false;
-    }
+        std::fill(m_changedValues.begin(), m_changedValues.end(), 0);
 
     if (m_objectUpdated)
     {
@@ -649,15 +633,13 @@ bool Object::LoadValues(const char* data)
 
 void Object::_SetUpdateBits(UpdateMask* updateMask, Player* /*target*/) const
 {
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (m_changedValues[index])
-            updateMask->SetBit(index);
+    updateMask->SetBlocks(&m_changedValues[0]);
 }
 
 void Object::_SetCreateBits(UpdateMask* updateMask, Player* /*target*/) const
 {
     for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (GetUInt32Value(index) != 0)
+        if (m_uint32Values[index] != 0)
             updateMask->SetBit(index);
 }
 
@@ -668,7 +650,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
     if (m_int32Values[index] != value)
     {
         m_int32Values[index] = value;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -680,7 +662,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
     if (m_uint32Values[index] != value)
     {
         m_uint32Values[index] = value;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -692,8 +674,8 @@ void Object::SetUInt64Value(uint16 index, const uint64& value)
     {
         m_uint32Values[index] = *((uint32*)&value);
         m_uint32Values[index + 1] = *(((uint32*)&value) + 1);
-        m_changedValues[index] = true;
-        m_changedValues[index + 1] = true;
+        MarkChangedValue(index);
+        MarkChangedValue(index + 1);
         MarkForClientUpdate();
     }
 }
@@ -705,7 +687,7 @@ void Object::SetFloatValue(uint16 index, float value)
     if (m_floatValues[index] != value)
     {
         m_floatValues[index] = value;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -724,7 +706,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFF) << (offset * 8));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -743,7 +725,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFFFF) << (offset * 16));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -805,7 +787,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -819,7 +801,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -837,7 +819,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
     if (!(uint8(m_uint32Values[index] >> (offset * 8)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -855,7 +837,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
     if (uint8(m_uint32Values[index] >> (offset * 8)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -867,7 +849,7 @@ void Object::SetShortFlag(uint16 index, bool highpart, uint16 newFlag)
     if (!(uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -879,7 +861,7 @@ void Object::RemoveShortFlag(uint16 index, bool highpart, uint16 oldFlag)
     if (uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -947,7 +929,7 @@ void Object::MarkForClientUpdate()
 
 void Object::ForceValuesUpdateAtIndex(uint32 index)
 {
-    m_changedValues[index] = true;
+    MarkChangedValue(index);
     if (m_inWorld && !m_objectUpdated)
     {
         AddToClientUpdateList();
@@ -980,7 +962,10 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     m_position.o = orientation;
 
     if (isType(TYPEMASK_UNIT))
+    {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, orientation);
+        ((Unit*)this)->UpdateGridIndex();
+    }
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -990,7 +975,10 @@ void WorldObject::Relocate(float x, float y, float z)
     m_position.z = z;
 
     if (isType(TYPEMASK_UNIT))
+    {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, GetOrientation());
+        ((Unit*)this)->UpdateGridIndex();
+    }
 }
 
 void WorldObject::SetOrientation(float orientation)
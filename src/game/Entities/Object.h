@@ -380,6 +380,8 @@ class Object
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
         void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
 
+        void MarkChangedValue(uint32 index) { m_changedValues[index >> 5] |= uint32(1) << (index & 0x1F); }
+
         uint16 m_objectType;
 
         uint8 m_objectTypeId;
@@ -392,7 +394,7 @@ class Object
             float*  m_floatValues;
         };
 
-        std::vector<bool> m_changedValues;
+        std::vector<uint32> m_changedValues;                // one bit per update field, same block layout as UpdateMask
 
         uint16 m_valuesCount;
 
@@ -58,6 +58,7 @@
 #include "Spells/Spell.h"
 #include "DBScripts/ScriptMgr.h"
 #include "Social/SocialMgr.h"
+#include "Social/PlayerDirectory.h"
 #include "Mails/Mail.h"
 #include "Server/DBCStores.h"
 #include "Server/SQLStorages.h"
@@ -444,6 +445,9 @@ Player::Player(WorldSession* session): Unit(), m_mover(this), m_camera(this), m_
     SetGroupInvite(nullptr);
     m_groupUpdateMask = 0;
     m_auraUpdateMask = 0;
+    m_groupUpdateTimer = 0;
+    m_groupUpdateKnownMask = 0;
+    memset(m_groupUpdateValues, 0, sizeof(m_groupUpdateValues));
 
     duel = nullptr;
 
@@ -1356,8 +1360,17 @@ void Player::Update(uint32 update_diff, uint32 p_time)
     UpdateEnchantTime(update_diff);
     UpdateHomebindTime(update_diff);
 
-    // Group update
-    SendUpdateToOutOfRangeGroupMembers();
+    // Group update, the changes of an interval are sent together
+    if (m_groupUpdateMask != GROUP_UPDATE_FLAG_NONE && GetGroup())
+        Group::AddChangedTick();
+
+    if (m_groupUpdateTimer <= update_diff)
+    {
+        SendUpdateToOutOfRangeGroupMembers();
+        m_groupUpdateTimer = sWorld.getConfig(CONFIG_INTERVAL_GROUP_UPDATE);
+    }
+    else
+        m_groupUpdateTimer -= update_diff;
 
     Pet* pet = GetPet();
     if (pet && !pet->IsWithinDistInMap(this, GetMap()->GetVisibilityDistance()) && (GetCharmGuid() && (pet->GetObjectGuid() != GetCharmGuid())))
@@ -3662,11 +3675,8 @@ void Player::_SetCreateBits(UpdateMask* updateMask, Player* target) const
     }
     else
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-        {
-            if (GetUInt32Value(index) != 0 && updateVisualBits.GetBit(index))
-                updateMask->SetBit(index);
-        }
+        Object::_SetCreateBits(updateMask, target);
+        *updateMask &= updateVisualBits;
     }
 }
 
@@ -6446,6 +6456,25 @@ void Player::ModifyArenaPoints(int32 value)
     SetArenaPoints(newValue);
 }
 
+void Player::SetInGuild(uint32 GuildId)
+{
+    uint32 oldGuildId = GetGuildId();
+    SetUInt32Value(PLAYER_GUILDID, GuildId);
+
+    sPlayerDirectory.UpdateGuild(this);
+
+    if (oldGuildId == GuildId)
+        return;
+
+    if (Guild* guild = sGuildMgr.GetGuildById(oldGuildId))
+        guild->RemoveOnlineMember(this);
+
+    // at login the player is added to the online members once it is accessible
+    if (ObjectAccessor::FindPlayer(GetObjectGuid(), false) == this)
+        if (Guild* guild = sGuildMgr.GetGuildById(GuildId))
+            guild->AddOnlineMember(this);
+}
+
 uint32 Player::GetGuildIdFromDB(ObjectGuid guid)
 {
     uint32 lowguid = guid.GetCounter();
@@ -6579,6 +6608,8 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
 
         SendInitWorldStates(newZone, newArea);              // only if really enters to new zone, not just area change, works strange...
 
+        sPlayerDirectory.UpdateZone(this, newZone);
+
         if (sWorld.getConfig(CONFIG_BOOL_WEATHER))
         {
             Weather* wth = GetMap()->GetWeatherSystem()->FindOrCreateWeather(newZone);
@@ -14047,7 +14078,7 @@ void Player::SendQuestGiverStatusMultiple() const
     WorldPacket data(SMSG_QUESTGIVER_STATUS_MULTIPLE, 4);
     data << uint32(count);                                  // placeholder
 
-    for (GuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+    for (ClientGuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
     {
         if (itr->IsAnyTypeCreature())
         {
@@ -18493,20 +18524,20 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(GuidSet& s64, T* target)
+inline void UpdateVisibilityOf_helper(ClientGuidSet& s64, T* target)
 {
     s64.insert(target->GetObjectGuid());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidSet& s64, GameObject* target)
+inline void UpdateVisibilityOf_helper(ClientGuidSet& s64, GameObject* target)
 {
     if (!target->IsTransport())
         s64.insert(target->GetObjectGuid());
 }
 
 template<class T>
-void Player::UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateData& data, std::set<WorldObject*>& visibleNow)
+void Player::UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateData& data, std::vector<WorldObject*>& visibleNow)
 {
     if (HaveAtClient(target))
     {
@@ -18526,7 +18557,7 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateD
     {
         if (target->isVisibleForInState(this, viewPoint, false))
         {
-            visibleNow.insert(target);
+            visibleNow.push_back(target);
             target->BuildCreateUpdateBlockForPlayer(&data, this);
             UpdateVisibilityOf_helper(m_clientGUIDs, target);
 
@@ -18535,11 +18566,11 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateD
     }
 }
 
-template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, Player*        target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, Creature*      target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, Corpse*        target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, GameObject*    target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, DynamicObject* target, UpdateData& data, std::set<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, Player*        target, UpdateData& data, std::vector<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, Creature*      target, UpdateData& data, std::vector<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, Corpse*        target, UpdateData& data, std::vector<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, GameObject*    target, UpdateData& data, std::vector<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(WorldObject const* viewPoint, DynamicObject* target, UpdateData& data, std::vector<WorldObject*>& visibleNow);
 
 void Player::InitPrimaryProfessions()
 {
@@ -18717,6 +18748,9 @@ void Player::SendUpdateToOutOfRangeGroupMembers()
 {
     if (m_groupUpdateMask == GROUP_UPDATE_FLAG_NONE)
         return;
+
+    RemoveUnchangedGroupUpdateFlags();
+
     if (Group* group = GetGroup())
         group->UpdatePlayerOutOfRange(this);
 
@@ -18726,6 +18760,66 @@ void Player::SendUpdateToOutOfRangeGroupMembers()
         pet->ResetAuraUpdateMask();
 }
 
+uint32 Player::GetGroupUpdateValue(uint32 flag) const
+{
+    // as written by WorldSession::BuildPartyMemberStatsChangedPacket
+    switch (flag)
+    {
+        case GROUP_UPDATE_FLAG_CUR_HP:      return uint16(GetHealth());
+        case GROUP_UPDATE_FLAG_MAX_HP:      return uint16(GetMaxHealth());
+        case GROUP_UPDATE_FLAG_CUR_POWER:   return uint16(GetPower(GetPowerType()));
+        case GROUP_UPDATE_FLAG_MAX_POWER:   return uint16(GetMaxPower(GetPowerType()));
+        case GROUP_UPDATE_FLAG_LEVEL:       return uint16(getLevel());
+        case GROUP_UPDATE_FLAG_ZONE:        return uint16(GetZoneId());
+        case GROUP_UPDATE_FLAG_POSITION:    return (uint32(uint16(GetPositionX())) << 16) | uint16(GetPositionY());
+        default:                            return 0;
+    }
+}
+
+void Player::RemoveUnchangedGroupUpdateFlags()
+{
+    // a full update was requested (teleport, login), everything is sent again
+    if ((m_groupUpdateMask & GROUP_UPDATE_FULL) == GROUP_UPDATE_FULL)
+        return;
+
+    // the power values of a new power type are always sent
+    uint32 keep = (m_groupUpdateMask & GROUP_UPDATE_FLAG_POWER_TYPE) ? uint32(GROUP_UPDATE_FLAG_CUR_POWER | GROUP_UPDATE_FLAG_MAX_POWER) : 0;
+
+    uint32 dropped = 0;
+    for (uint32 i = 0; i < GROUP_UPDATE_VALUES_COUNT; ++i)
+    {
+        uint32 flag = GroupUpdateValueFlags[i];
+        if (!(m_groupUpdateMask & flag & m_groupUpdateKnownMask) || (flag & keep))
+            continue;
+
+        if (GetGroupUpdateValue(flag) == m_groupUpdateValues[i])
+        {
+            m_groupUpdateMask &= ~flag;
+            ++dropped;
+        }
+    }
+
+    if (dropped)
+        Group::AddDroppedFields(dropped);
+}
+
+void Player::StoreSentGroupUpdateValues()
+{
+    uint32 mask = m_groupUpdateMask;
+    if (mask & GROUP_UPDATE_FLAG_POWER_TYPE)
+        mask |= (GROUP_UPDATE_FLAG_CUR_POWER | GROUP_UPDATE_FLAG_MAX_POWER);
+
+    for (uint32 i = 0; i < GROUP_UPDATE_VALUES_COUNT; ++i)
+    {
+        uint32 flag = GroupUpdateValueFlags[i];
+        if (!(mask & flag))
+            continue;
+
+        m_groupUpdateValues[i] = GetGroupUpdateValue(flag);
+        m_groupUpdateKnownMask |= flag;
+    }
+}
+
 void Player::SendTransferAbortedByLockStatus(MapEntry const* mapEntry, AreaLockStatus lockStatus, uint32 miscRequirement) const
 {
     MANGOS_ASSERT(mapEntry);
@@ -19227,7 +19321,7 @@ void Player::UpdateForQuestWorldObjects()
 
     UpdateData udata;
     WorldPacket packet;
-    for (GuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+    for (ClientGuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
     {
         if (itr->IsGameObject())
         {
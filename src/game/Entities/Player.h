@@ -31,6 +31,8 @@
 #include "Server/WorldSession.h"
 #include "Entities/Pet.h"
 #include "Maps/MapReference.h"
+#include "Grids/IndexedGridReference.h"
+#include "Entities/ClientGuidSet.h"
 #include "Util.h"                                           // for Tokens typedef
 #include "Reputation/ReputationMgr.h"
 #include "BattleGround/BattleGround.h"
@@ -1591,8 +1593,9 @@ class Player : public Unit
         static void RemoveFromGroup(Group* group, ObjectGuid guid);
         void RemoveFromGroup() { RemoveFromGroup(GetGroup(), GetObjectGuid()); }
         void SendUpdateToOutOfRangeGroupMembers();
+        uint32 GetGroupUpdateValue(uint32 flag) const;
 
-        void SetInGuild(uint32 GuildId) { SetUInt32Value(PLAYER_GUILDID, GuildId); }
+        void SetInGuild(uint32 GuildId);
         void SetRank(uint32 rankId) { SetUInt32Value(PLAYER_GUILDRANK, rankId); }
         void SetGuildIdInvited(uint32 GuildId) { m_GuildIdInvited = GuildId; }
         uint32 GetGuildId() const { return GetUInt32Value(PLAYER_GUILDID);  }
@@ -2068,9 +2071,9 @@ class Player : public Unit
         Object* GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask);
 
         // currently visible objects at player client
-        GuidSet m_clientGUIDs;
+        ClientGuidSet m_clientGUIDs;
 
-        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.find(u->GetObjectGuid()) != m_clientGUIDs.end(); }
+        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.count(u->GetObjectGuid()) != 0; }
 
         bool IsVisibleInGridForPlayer(Player* pl) const override;
         bool IsVisibleGloballyFor(Player* pl) const;
@@ -2078,7 +2081,7 @@ class Player : public Unit
         void UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* target);
 
         template<class T>
-        void UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateData& data, std::set<WorldObject*>& visibleNow);
+        void UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateData& data, std::vector<WorldObject*>& visibleNow);
 
         // Stealth detection system
         void HandleStealthedUnitsDetection();
@@ -2141,6 +2144,10 @@ class Player : public Unit
         uint8 GetSubGroup() const { return m_group.getSubGroup(); }
         uint32 GetGroupUpdateFlag() const { return m_groupUpdateMask; }
         void SetGroupUpdateFlag(uint32 flag) { m_groupUpdateMask |= flag; }
+        // plain number fields known to the whole group are left out of the next update while unchanged
+        void RemoveUnchangedGroupUpdateFlags();
+        void StoreSentGroupUpdateValues();
+        void ForgetSentGroupUpdateValues() { m_groupUpdateKnownMask = 0; }
         const uint64& GetAuraUpdateMask() const { return m_auraUpdateMask; }
         void SetAuraUpdateMask(uint8 slot) { m_auraUpdateMask |= (uint64(1) << slot); }
         Player* GetNextRandomRaidMember(float radius);
@@ -2154,7 +2161,7 @@ class Player : public Unit
         uint8 GetOriginalSubGroup() const { return m_originalGroup.getSubGroup(); }
         void SetOriginalGroup(Group* group, int8 subgroup = -1);
 
-        GridReference<Player>& GetGridRef() { return m_gridRef; }
+        IndexedGridReference<Player>& GetGridRef() { return m_gridRef; }
         MapReference& GetMapRef() { return m_mapRef; }
 
         DeclinedName const* GetDeclinedNames() const { return m_declinedname; }
@@ -2363,6 +2370,9 @@ class Player : public Unit
         Group* m_groupInvite;
         uint32 m_groupUpdateMask;
         uint64 m_auraUpdateMask;
+        uint32 m_groupUpdateTimer;
+        uint32 m_groupUpdateKnownMask;                      // flags of the values in m_groupUpdateValues
+        uint32 m_groupUpdateValues[GROUP_UPDATE_VALUES_COUNT];
 
         ObjectGuid m_miniPetGuid;
 
@@ -2407,7 +2417,7 @@ class Player : public Unit
         Unit* m_mover;
         Camera m_camera;
 
-        GridReference<Player> m_gridRef;
+        IndexedGridReference<Player> m_gridRef;
         MapReference m_mapRef;
 
         // Homebind coordinates
@@ -46,6 +46,7 @@
 #include "Movement/MoveSplineInit.h"
 #include "Movement/MoveSpline.h"
 #include "Entities/CreatureLinkingMgr.h"
+#include "Social/PlayerDirectory.h"
 
 #include <math.h>
 #include <array>
@@ -492,11 +493,17 @@ void Unit::Update(uint32 update_diff, uint32 p_time)
     // update abilities available only for fraction of time
     UpdateReactives(update_diff);
 
-    UpdateSplineMovement(p_time);
-    i_motionMaster.UpdateMotion(p_time);
+    {
+        ProfileScope profileScope("movement");
+        UpdateSplineMovement(p_time);
+        i_motionMaster.UpdateMotion(p_time);
+    }
 
     if (AI() && isAlive())
+    {
+        ProfileScope profileScope("ai");
         AI()->UpdateAI(p_time);   // AI not react good at real update delays (while freeze in non-active part of map)
+    }
 
     if (isAlive())
     {
@@ -8747,9 +8754,14 @@ void Unit::SetLevel(uint32 lvl)
 {
     SetUInt32Value(UNIT_FIELD_LEVEL, lvl);
 
-    // group update
-    if ((GetTypeId() == TYPEID_PLAYER) && ((Player*)this)->GetGroup())
-        ((Player*)this)->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        sPlayerDirectory.UpdateLevel((Player*)this);
+
+        // group update
+        if (((Player*)this)->GetGroup())
+            ((Player*)this)->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
+    }
 }
 
 void Unit::SetHealth(uint32 val)
@@ -9842,12 +9854,21 @@ void Unit::SetDisplayId(uint32 modelId)
     }
 }
 
+void Unit::UpdateGridIndex()
+{
+    if (GetTypeId() == TYPEID_PLAYER)
+        ((Player*)this)->GetGridRef().UpdatePosition();
+    else
+        ((Creature*)this)->GetGridRef().UpdatePosition();
+}
+
 void Unit::UpdateModelData()
 {
     if (CreatureModelInfo const* modelInfo = sObjectMgr.GetCreatureModelInfo(GetDisplayId()))
     {
         // we expect values in database to be relative to scale = 1.0
         SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, GetObjectScale() * modelInfo->bounding_radius);
+        UpdateGridIndex();
 
         // never actually update combat_reach for player, it's always the same. Below player case is for initialization
         if (GetTypeId() == TYPEID_PLAYER)
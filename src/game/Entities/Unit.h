@@ -2055,6 +2055,8 @@ class Unit : public WorldObject
 
         // at any changes to scale and/or displayId
         void UpdateModelData();
+        // at any changes to position and/or bounding radius, keeps the cell position index in sync
+        void UpdateGridIndex();
 
         DynamicObject* GetDynObject(uint32 spellId, SpellEffectIndex effIndex);
         DynamicObject* GetDynObject(uint32 spellId);
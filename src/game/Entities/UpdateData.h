@@ -54,6 +54,8 @@ class UpdateData
         void AddOutOfRangeGUID(GuidSet& guids);
         void AddOutOfRangeGUID(ObjectGuid const& guid);
         void AddUpdateBlock(const ByteBuffer& block);
+        /// Starts a new update block, the caller appends its content directly to the returned buffer
+        ByteBuffer& AddUpdateBlock() { ++m_blockCount; return m_data; }
         bool BuildPacket(WorldPacket& packet, bool hasTransport = false);
         bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
         void Clear();
@@ -20,58 +20,91 @@
 #define __UPDATEMASK_H
 
 #include "Errors.h"
+#include "Entities/UpdateFields.h"
 
+#if COMPILER == COMPILER_MICROSOFT
+#  include <intrin.h>
+#endif
+
+/**
+ * Bit set over the update fields of an object.
+ *
+ * Storage is a fixed block array large enough for the biggest object (player), so masks
+ * can live on the stack while building update blocks without touching the heap.
+ */
 class UpdateMask
 {
     public:
-        UpdateMask() : mCount(0), mBlocks(0), mUpdateMask(nullptr) { }
-        UpdateMask(const UpdateMask& mask) : mUpdateMask(nullptr) { *this = mask; }
+        static uint32 const MaxValuesCount = PLAYER_END;
+        static uint32 const MaxBlocks = (MaxValuesCount + 31) / 32;
 
-        ~UpdateMask()
-        {
-            delete[] mUpdateMask;
-        }
+        UpdateMask() : mCount(0), mBlocks(0) { }
+        UpdateMask(const UpdateMask& mask) { *this = mask; }
 
         void SetBit(uint32 index)
         {
-            ((uint8*)mUpdateMask)[ index >> 3 ] |= 1 << (index & 0x7);
+            mUpdateMask[index >> 5] |= uint32(1) << (index & 0x1F);
         }
 
         void UnsetBit(uint32 index)
         {
-            ((uint8*)mUpdateMask)[ index >> 3 ] &= (0xff ^ (1 << (index & 0x7)));
+            mUpdateMask[index >> 5] &= ~(uint32(1) << (index & 0x1F));
         }
 
         bool GetBit(uint32 index) const
         {
-            return (((uint8*)mUpdateMask)[ index >> 3 ] & (1 << (index & 0x7))) != 0;
+            return (mUpdateMask[index >> 5] & (uint32(1) << (index & 0x1F))) != 0;
+        }
+
+        /// Returns first set bit at or after index, or GetCount() if there is none
+        uint32 FindNextSetBit(uint32 index) const
+        {
+            if (index >= mCount)
+                return mCount;
+
+            uint32 block = index >> 5;
+            uint32 bits = mUpdateMask[block] & (~uint32(0) << (index & 0x1F));
+
+            while (!bits)
+            {
+                if (++block >= mBlocks)
+                    return mCount;
+                bits = mUpdateMask[block];
+            }
+
+            return (block << 5) + CountTrailingZeros(bits);
         }
 
         uint32 GetBlockCount() const { return mBlocks; }
         uint32 GetLength() const { return mBlocks << 2; }
         uint32 GetCount() const { return mCount; }
-        uint8* GetMask() { return (uint8*)mUpdateMask; }
+        uint32 GetBlock(uint32 block) const { return mUpdateMask[block]; }
 
         void SetCount(uint32 valuesCount)
         {
-            delete[] mUpdateMask;
+            MANGOS_ASSERT(valuesCount <= MaxValuesCount);
 
             mCount = valuesCount;
             mBlocks = (valuesCount + 31) / 32;
 
-            mUpdateMask = new uint32[mBlocks];
             memset(mUpdateMask, 0, mBlocks << 2);
         }
 
+        /// Replaces the mask content by GetBlockCount() raw blocks
+        void SetBlocks(uint32 const* blocks)
+        {
+            memcpy(mUpdateMask, blocks, mBlocks << 2);
+        }
+
         void Clear()
         {
-            if (mUpdateMask)
-                memset(mUpdateMask, 0, mBlocks << 2);
+            memset(mUpdateMask, 0, mBlocks << 2);
         }
 
         UpdateMask& operator = (const UpdateMask& mask)
         {
-            SetCount(mask.mCount);
+            mCount = mask.mCount;
+            mBlocks = mask.mBlocks;
             memcpy(mUpdateMask, mask.mUpdateMask, mBlocks << 2);
 
             return *this;
@@ -80,14 +113,16 @@ class UpdateMask
         void operator &= (const UpdateMask& mask)
         {
             MANGOS_ASSERT(mask.mCount <= mCount);
-            for (uint32 i = 0; i < mBlocks; ++i)
+            for (uint32 i = 0; i < mask.mBlocks; ++i)
                 mUpdateMask[i] &= mask.mUpdateMask[i];
+            for (uint32 i = mask.mBlocks; i < mBlocks; ++i)
+                mUpdateMask[i] = 0;
         }
 
         void operator |= (const UpdateMask& mask)
         {
             MANGOS_ASSERT(mask.mCount <= mCount);
-            for (uint32 i = 0; i < mBlocks; ++i)
+            for (uint32 i = 0; i < mask.mBlocks; ++i)
                 mUpdateMask[i] |= mask.mUpdateMask[i];
         }
 
@@ -114,8 +149,19 @@ class UpdateMask
         }
 
     private:
+        static uint32 CountTrailingZeros(uint32 bits)
+        {
+#if COMPILER == COMPILER_MICROSOFT
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return uint32(index);
+#else
+            return uint32(__builtin_ctz(bits));
+#endif
+        }
+
         uint32 mCount;
         uint32 mBlocks;
-        uint32* mUpdateMask;
+        uint32 mUpdateMask[MaxBlocks];
 };
 #endif
@@ -28,6 +28,7 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "Entities/ObjectGuid.h"
 #include "World/World.h"
+#include "Social/PlayerDirectory.h"
 
 #include <mutex>
 
@@ -85,22 +86,21 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->second->IsInWorld() && (::strcmp(name, iter->second->GetName()) == 0))
-            return iter->second;
+    // the directory lookup is case insensitive
+    Player* player = sPlayerDirectory.FindPlayerByName(name);
+    if (!player || !player->IsInWorld() || ::strcmp(name, player->GetName()) != 0)
+        return nullptr;
 
-    return nullptr;
+    return player;
 }
 
 void
 ObjectAccessor::SaveAllPlayers() const
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        itr->second->SaveToDB();
+    HashMapHolder<Player>::ObjectList players;
+    GetPlayers(players);
+    for (HashMapHolder<Player>::ObjectList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        (*itr)->SaveToDB();
 }
 
 void ObjectAccessor::KickPlayer(ObjectGuid guid)
@@ -268,8 +268,7 @@ void ObjectAccessor::RemoveOldCorpses()
 
 /// Define the static member of HashMapHolder
 
-template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
-template <class T> std::mutex HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::m_shards[HASHMAP_HOLDER_SHARDS];
 
 /// Global definitions for the hashmap storage
 
@@ -31,52 +31,151 @@
 #include "Entities/Player.h"
 #include "Entities/Corpse.h"
 
+#include <atomic>
 #include <mutex>
+#include <vector>
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
 
 class Unit;
 class WorldObject;
 class Map;
 
+#define HASHMAP_HOLDER_SHARDS 16
+
+/// Lock statistics of a HashMapHolder, waits count the lock requests that did not get the lock at once
+struct HashMapHolderStats
+{
+    HashMapHolderStats() : reads(0), readWaits(0), writes(0), writeWaits(0) {}
+
+    uint64 reads;
+    uint64 readWaits;
+    uint64 writes;
+    uint64 writeWaits;
+};
+
+/**
+ * Global guid registry of one object type.
+ *
+ * The map is split into HASHMAP_HOLDER_SHARDS shards by guid counter, each behind its own
+ * reader-writer lock, so lookups from the map update threads only share a shard lock and
+ * never wait for each other, and inserts only block the lookups of one shard.
+ */
 template <class T>
 class HashMapHolder
 {
     public:
 
         typedef std::unordered_map<ObjectGuid, T*>   MapType;
-        typedef std::mutex LockType;
-        typedef std::lock_guard<std::mutex> ReadGuard;
-        typedef std::lock_guard<std::mutex> WriteGuard;
+        typedef std::vector<T*> ObjectList;
+        typedef boost::shared_mutex LockType;
+        typedef boost::shared_lock<LockType> ReadGuard;
+        typedef boost::unique_lock<LockType> WriteGuard;
 
         static void Insert(T* o)
         {
-            WriteGuard guard(i_lock);
-            m_objectMap[o->GetObjectGuid()] = o;
+            Shard& shard = GetShard(o->GetObjectGuid());
+            WriteGuard guard(LockExclusive(shard), boost::adopt_lock);
+            shard.objectMap[o->GetObjectGuid()] = o;
         }
 
         static void Remove(T* o)
         {
-            WriteGuard guard(i_lock);
-            m_objectMap.erase(o->GetObjectGuid());
+            Shard& shard = GetShard(o->GetObjectGuid());
+            WriteGuard guard(LockExclusive(shard), boost::adopt_lock);
+            shard.objectMap.erase(o->GetObjectGuid());
         }
 
         static T* Find(ObjectGuid guid)
         {
-            ReadGuard guard(i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : nullptr;
+            Shard& shard = GetShard(guid);
+            ReadGuard guard(LockShared(shard), boost::adopt_lock);
+            typename MapType::const_iterator itr = shard.objectMap.find(guid);
+            return (itr != shard.objectMap.end()) ? itr->second : nullptr;
         }
 
-        static MapType& GetContainer() { return m_objectMap; }
+        /// Copies all objects, every shard is locked only while it is copied
+        static void GetObjects(ObjectList& objects)
+        {
+            for (uint32 i = 0; i < HASHMAP_HOLDER_SHARDS; ++i)
+            {
+                Shard& shard = m_shards[i];
+                ReadGuard guard(LockShared(shard), boost::adopt_lock);
+                for (typename MapType::const_iterator itr = shard.objectMap.begin(); itr != shard.objectMap.end(); ++itr)
+                    objects.push_back(itr->second);
+            }
+        }
 
-        static LockType& GetLock() { return i_lock; }
+        static void GetStats(HashMapHolderStats& stats)
+        {
+            for (uint32 i = 0; i < HASHMAP_HOLDER_SHARDS; ++i)
+            {
+                Shard const& shard = m_shards[i];
+                stats.reads += shard.reads.load(std::memory_order_relaxed);
+                stats.readWaits += shard.readWaits.load(std::memory_order_relaxed);
+                stats.writes += shard.writes.load(std::memory_order_relaxed);
+                stats.writeWaits += shard.writeWaits.load(std::memory_order_relaxed);
+            }
+        }
+
+        static void ResetStats()
+        {
+            for (uint32 i = 0; i < HASHMAP_HOLDER_SHARDS; ++i)
+            {
+                Shard& shard = m_shards[i];
+                shard.reads = 0;
+                shard.readWaits = 0;
+                shard.writes = 0;
+                shard.writeWaits = 0;
+            }
+        }
 
     private:
 
+        // cache line aligned, lookups of different shards do not share the lock state
+        struct alignas(64) Shard
+        {
+            Shard() : reads(0), readWaits(0), writes(0), writeWaits(0) {}
+
+            LockType lock;
+            MapType objectMap;
+
+            // per shard, a global counter would be a contention point of its own
+            std::atomic<uint64> reads;
+            std::atomic<uint64> readWaits;
+            std::atomic<uint64> writes;
+            std::atomic<uint64> writeWaits;
+        };
+
+        static Shard& GetShard(ObjectGuid guid) { return m_shards[guid.GetCounter() % HASHMAP_HOLDER_SHARDS]; }
+
+        static LockType& LockShared(Shard& shard)
+        {
+            shard.reads.fetch_add(1, std::memory_order_relaxed);
+            if (!shard.lock.try_lock_shared())
+            {
+                shard.readWaits.fetch_add(1, std::memory_order_relaxed);
+                shard.lock.lock_shared();
+            }
+            return shard.lock;
+        }
+
+        static LockType& LockExclusive(Shard& shard)
+        {
+            shard.writes.fetch_add(1, std::memory_order_relaxed);
+            if (!shard.lock.try_lock())
+            {
+                shard.writeWaits.fetch_add(1, std::memory_order_relaxed);
+                shard.lock.lock();
+            }
+            return shard.lock;
+        }
+
         // Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
-        static MapType  m_objectMap;
+        static Shard m_shards[HASHMAP_HOLDER_SHARDS];
 };
 
 class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLevelLockable<ObjectAccessor, std::mutex> >
@@ -100,9 +199,10 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
         static Player* FindPlayerByName(const char* name);
         static void KickPlayer(ObjectGuid guid);
 
-        HashMapHolder<Player>::MapType& GetPlayers()
+        // snapshot of the online players, pointers stay valid until the world thread deletes a player
+        void GetPlayers(HashMapHolder<Player>::ObjectList& players) const
         {
-            return HashMapHolder<Player>::GetContainer();
+            HashMapHolder<Player>::GetObjects(players);
         }
 
         void SaveAllPlayers() const;
@@ -711,8 +711,7 @@ void ObjectMgr::ConvertCreatureAddonAuras(CreatureDataAddon* addon, char const*
         if (p != s)
             val.push_back(atoi(s));
 
-        // free char* loaded memory
-        delete[](char*)reinterpret_cast<char const*>(addon->auras);
+        // the string stays in the string arena of the table
     }
 
     // empty list
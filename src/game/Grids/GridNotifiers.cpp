@@ -39,26 +39,28 @@ void VisibleChangesNotifier::Visit(CameraMapType& m)
 void VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    // at this moment client guids not touched by this pass have not been iterated at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (Transport* transport = player.GetTransport())
     {
         for (Transport::PlayerSet::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
         {
-            if (i_clientGUIDs.find((*itr)->GetObjectGuid()) != i_clientGUIDs.end())
+            if (!player.m_clientGUIDs.IsSeenSince((*itr)->GetObjectGuid(), i_passStamp))
             {
                 // ignore far sight case
                 (*itr)->UpdateVisibilityOf(*itr, &player);
                 player.UpdateVisibilityOf(&player, *itr, i_data, i_visibleNow);
-                i_clientGUIDs.erase((*itr)->GetObjectGuid());
+                player.m_clientGUIDs.Touch((*itr)->GetObjectGuid());
             }
         }
     }
 
     // generate outOfRange for not iterate objects
-    i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
+    GuidVector outOfRange;
+    player.m_clientGUIDs.CollectUnseen(i_passStamp, outOfRange);
+    for (GuidVector::const_iterator itr = outOfRange.begin(); itr != outOfRange.end(); ++itr)
     {
+        i_data.AddOutOfRangeGUID(*itr);
         player.m_clientGUIDs.erase(*itr);
 
         DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is out of range (no in active cells set) now for %s",
@@ -87,7 +89,7 @@ void VisibleNotifier::Notify()
     // Now do operations that required done at object visibility change to visible
 
     // send data at target visibility change (adding to client)
-    for (std::set<WorldObject*>::const_iterator vItr = i_visibleNow.begin(); vItr != i_visibleNow.end(); ++vItr)
+    for (std::vector<WorldObject*>::const_iterator vItr = i_visibleNow.begin(); vItr != i_visibleNow.end(); ++vItr)
     {
         // target aura duration for caster show only if target exist at caster client
         if ((*vItr) != &player && (*vItr)->isType(TYPEMASK_UNIT))
@@ -36,10 +36,10 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
-        std::set<WorldObject*> i_visibleNow;
+        uint32 i_passStamp;                                 // client guids not touched since then are out of range
+        std::vector<WorldObject*> i_visibleNow;
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) {}
+        explicit VisibleNotifier(Camera& c) : i_camera(c), i_passStamp(c.GetOwner()->m_clientGUIDs.BeginPass()) {}
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
@@ -322,6 +322,8 @@ namespace MaNGOS
         void Visit(CreatureMapType& m);
         void Visit(PlayerMapType& m);
 
+        bool operator()(Unit* u);                          // cell candidate, false when search is done
+
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
 
@@ -337,6 +339,8 @@ namespace MaNGOS
         void Visit(CreatureMapType& m);
         void Visit(PlayerMapType& m);
 
+        bool operator()(Unit* u);
+
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
 
@@ -352,6 +356,8 @@ namespace MaNGOS
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
 
+        bool operator()(Unit* u);
+
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
 
@@ -367,6 +373,8 @@ namespace MaNGOS
 
         void Visit(CreatureMapType& m);
 
+        bool operator()(Creature* c);
+
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
 
@@ -381,6 +389,8 @@ namespace MaNGOS
 
         void Visit(CreatureMapType& m);
 
+        bool operator()(Creature* c);
+
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
 
@@ -394,6 +404,8 @@ namespace MaNGOS
 
         void Visit(CreatureMapType& m);
 
+        bool operator()(Creature* c);
+
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
 
@@ -798,10 +810,26 @@ namespace MaNGOS
             float i_range;
     };
 
-    class AnyUnitInObjectRangeCheck
+    // Range checks deriving from this expose their search circle: unit and creature searchers then take
+    // candidates from the cell position index (GridRefIndex) instead of visiting every object of the cell.
+    // The area must contain everything the check can accept, checks themselves stay exact.
+    class UnitRangeCheckArea
+    {
+        public:
+            UnitRangeCheckArea(WorldObject const* center, float range) : i_areaCenter(center), i_areaRange(range) {}
+
+            WorldObject const* GetAreaCenter() const { return i_areaCenter; }
+            float GetAreaRange() const { return i_areaRange; }
+
+        private:
+            WorldObject const* i_areaCenter;
+            float i_areaRange;
+    };
+
+    class AnyUnitInObjectRangeCheck : public UnitRangeCheckArea
     {
         public:
-            AnyUnitInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
+            AnyUnitInObjectRangeCheck(WorldObject const* obj, float range) : UnitRangeCheckArea(obj, range), i_obj(obj), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
             bool operator()(Unit* u)
             {
@@ -816,10 +844,10 @@ namespace MaNGOS
     };
 
     // Success at unit in range, range update for next check (this can be use with UnitLastSearcher to find nearest unit)
-    class NearestAttackableUnitInObjectRangeCheck
+    class NearestAttackableUnitInObjectRangeCheck : public UnitRangeCheckArea
     {
         public:
-            NearestAttackableUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : i_obj(obj), i_funit(funit), i_range(range) {}
+            NearestAttackableUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : UnitRangeCheckArea(obj, range), i_obj(obj), i_funit(funit), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
             bool operator()(Unit* u)
             {
@@ -841,11 +869,11 @@ namespace MaNGOS
             NearestAttackableUnitInObjectRangeCheck(NearestAttackableUnitInObjectRangeCheck const&);
     };
 
-    class AnyAoEVisibleTargetUnitInObjectRangeCheck
+    class AnyAoEVisibleTargetUnitInObjectRangeCheck : public UnitRangeCheckArea
     {
         public:
             AnyAoEVisibleTargetUnitInObjectRangeCheck(WorldObject const* obj, WorldObject const* originalCaster, float range)
-                : i_obj(obj), i_originalCaster(originalCaster), i_range(range)
+                : UnitRangeCheckArea(obj, range), i_obj(obj), i_originalCaster(originalCaster), i_range(range)
             {
                 i_targetForUnit = i_originalCaster->isType(TYPEMASK_UNIT);
                 i_targetForPlayer = (i_originalCaster->GetTypeId() == TYPEID_PLAYER);
@@ -878,11 +906,11 @@ namespace MaNGOS
             bool i_targetForPlayer;
     };
 
-    class AnyAoETargetUnitInObjectRangeCheck
+    class AnyAoETargetUnitInObjectRangeCheck : public UnitRangeCheckArea
     {
         public:
             AnyAoETargetUnitInObjectRangeCheck(WorldObject const* obj, float range)
-                : i_obj(obj), i_range(range)
+                : UnitRangeCheckArea(obj, range), i_obj(obj), i_range(range)
             {
                 i_targetForPlayer = i_obj->IsControlledByPlayer();
             }
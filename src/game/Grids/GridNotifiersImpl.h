@@ -32,10 +32,11 @@
 template<class T>
 inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
 {
+    ClientGuidSet& clientGUIDs = i_camera.GetOwner()->m_clientGUIDs;
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
-        i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
+        clientGUIDs.Touch(iter->getSource()->GetObjectGuid());
     }
 }
 
@@ -374,23 +375,52 @@ void MaNGOS::GameObjectListSearcher<Check>::Visit(GameObjectMapType& m)
 
 // Unit searchers
 
-template<class Check>
-void MaNGOS::UnitSearcher<Check>::Visit(CreatureMapType& m)
+namespace MaNGOS
 {
-    // already found
-    if (i_object)
-        return;
+    // feeds searcher with all objects of the cell, used for checks without a known search area
+    template<class T, class SEARCHER>
+    inline void VisitCandidates(GridRefManager<T>& m, void const* /*check*/, SEARCHER& searcher)
+    {
+        for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+            if (!searcher(itr->getSource()))
+                return;
+    }
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    // feeds searcher only with objects of the cell that may be within the check's area
+    template<class T, class SEARCHER>
+    inline void VisitCandidates(GridRefManager<T>& m, UnitRangeCheckArea const* area, SEARCHER& searcher)
     {
-        if (i_check(itr->getSource()))
+        if (!m.IsFullyIndexed())
         {
-            i_object = itr->getSource();
+            VisitCandidates(m, static_cast<void const*>(area), searcher);
             return;
         }
+
+        WorldObject const* center = area->GetAreaCenter();
+        m.GetIndex()->VisitInRange(center->GetPositionX(), center->GetPositionY(), area->GetAreaRange() + center->GetObjectBoundingRadius(), searcher);
     }
 }
 
+template<class Check>
+bool MaNGOS::UnitSearcher<Check>::operator()(Unit* u)
+{
+    if (!i_check(u))
+        return true;
+
+    i_object = u;
+    return false;
+}
+
+template<class Check>
+void MaNGOS::UnitSearcher<Check>::Visit(CreatureMapType& m)
+{
+    // already found
+    if (i_object)
+        return;
+
+    VisitCandidates(m, &i_check, *this);
+}
+
 template<class Check>
 void MaNGOS::UnitSearcher<Check>::Visit(PlayerMapType& m)
 {
@@ -398,54 +428,61 @@ void MaNGOS::UnitSearcher<Check>::Visit(PlayerMapType& m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+    VisitCandidates(m, &i_check, *this);
+}
+
+template<class Check>
+bool MaNGOS::UnitLastSearcher<Check>::operator()(Unit* u)
+{
+    if (i_check(u))
+        i_object = u;
+    return true;
 }
 
 template<class Check>
 void MaNGOS::UnitLastSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    VisitCandidates(m, &i_check, *this);
 }
 
 template<class Check>
 void MaNGOS::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    VisitCandidates(m, &i_check, *this);
+}
+
+template<class Check>
+bool MaNGOS::UnitListSearcher<Check>::operator()(Unit* u)
+{
+    if (i_check(u))
+        i_objects.push_back(u);
+    return true;
 }
 
 template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+    VisitCandidates(m, &i_check, *this);
 }
 
 template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+    VisitCandidates(m, &i_check, *this);
 }
 
 // Creature searchers
 
+template<class Check>
+bool MaNGOS::CreatureSearcher<Check>::operator()(Creature* c)
+{
+    if (!i_check(c))
+        return true;
+
+    i_object = c;
+    return false;
+}
+
 template<class Check>
 void MaNGOS::CreatureSearcher<Check>::Visit(CreatureMapType& m)
 {
@@ -453,32 +490,35 @@ void MaNGOS::CreatureSearcher<Check>::Visit(CreatureMapType& m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+    VisitCandidates(m, &i_check, *this);
+}
+
+template<class Check>
+bool MaNGOS::CreatureLastSearcher<Check>::operator()(Creature* c)
+{
+    if (i_check(c))
+        i_object = c;
+    return true;
 }
 
 template<class Check>
 void MaNGOS::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    VisitCandidates(m, &i_check, *this);
+}
+
+template<class Check>
+bool MaNGOS::CreatureListSearcher<Check>::operator()(Creature* c)
+{
+    if (i_check(c))
+        i_objects.push_back(c);
+    return true;
 }
 
 template<class Check>
 void MaNGOS::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+    VisitCandidates(m, &i_check, *this);
 }
 
 template<class Check>
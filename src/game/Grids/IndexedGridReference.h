@@ -0,0 +1,83 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_INDEXEDGRIDREFERENCE_H
+#define MANGOS_INDEXEDGRIDREFERENCE_H
+
+#include "GameSystem/GridReference.h"
+#include "GameSystem/GridRefManager.h"
+
+/**
+ * Grid reference of units that keeps the cell's position index (GridRefIndex) in sync.
+ * The owner must call UpdatePosition() after every position or bounding radius change.
+ */
+template<class OBJECT>
+class IndexedGridReference : public GridReference<OBJECT>
+{
+    public:
+
+        // unlink here, the base destructor would no longer reach the overrides below
+        ~IndexedGridReference() { this->unlink(); }
+
+        void UpdatePosition()
+        {
+            if (!this->isValid())
+                return;
+
+            if (GridRefIndex<OBJECT>* index = this->getTarget()->GetIndex())
+            {
+                OBJECT const* obj = this->getSource();
+                index->Update(this->GetIndexSlot(), obj->GetPositionX(), obj->GetPositionY(), obj->GetObjectBoundingRadius());
+            }
+        }
+
+    protected:
+
+        void targetObjectBuildLink() override
+        {
+            GridReference<OBJECT>::targetObjectBuildLink();
+
+            OBJECT const* obj = this->getSource();
+            this->SetIndexSlot(this->getTarget()->GetOrCreateIndex().Add(this, obj->GetPositionX(), obj->GetPositionY(), obj->GetObjectBoundingRadius()));
+        }
+
+        void targetObjectDestroyLink() override
+        {
+            if (this->isValid())
+                RemoveFromIndex();
+
+            GridReference<OBJECT>::targetObjectDestroyLink();
+        }
+
+        void sourceObjectDestroyLink() override
+        {
+            RemoveFromIndex();
+
+            GridReference<OBJECT>::sourceObjectDestroyLink();
+        }
+
+    private:
+
+        void RemoveFromIndex()
+        {
+            if (GridRefIndex<OBJECT>* index = this->getTarget()->GetIndex())
+                index->Remove(this->GetIndexSlot());
+        }
+};
+
+#endif
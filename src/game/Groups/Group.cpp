@@ -56,6 +56,12 @@ GroupMemberStatus GetGroupMemberStatus(const Player *member = nullptr)
 //============== Group ==============================
 //===================================================
 
+std::atomic<uint64> Group::m_updateChangedTicks(0);
+std::atomic<uint64> Group::m_updateBuilt(0);
+std::atomic<uint64> Group::m_updateDroppedFields(0);
+std::atomic<uint64> Group::m_updateSent(0);
+std::atomic<uint64> Group::m_updateSentBytes(0);
+
 Group::Group() : m_Id(0), m_groupType(GROUPTYPE_NORMAL),
     m_difficulty(REGULAR_DIFFICULTY),
     m_bgGroup(nullptr), m_lootMethod(FREE_FOR_ALL), m_lootThreshold(ITEM_QUALITY_UNCOMMON),
@@ -538,9 +544,38 @@ void Group::SendTargetIconList(WorldSession* session) const
 
 void Group::SendUpdate()
 {
+    // online members are linked to the group, each one is found and its status built once instead of per receiver
+    std::vector<Player*> players;
+    std::vector<uint8> statuses;
+    players.reserve(m_memberSlots.size());
+    statuses.reserve(m_memberSlots.size());
+
     for (member_citerator citr = m_memberSlots.begin(); citr != m_memberSlots.end(); ++citr)
     {
-        Player* player = sObjectMgr.GetPlayer(citr->guid);
+        Player* player = nullptr;
+        for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
+        {
+            Player* member = itr->getSource();
+            if (member && member->GetObjectGuid() == citr->guid)
+            {
+                if (member->IsInWorld())
+                    player = member;
+                break;
+            }
+        }
+
+        players.push_back(player);
+        statuses.push_back(uint8(GetGroupMemberStatus(player)));
+
+        // the members changed, a new one does not know the values left out of stats updates
+        if (player)
+            player->ForgetSentGroupUpdateValues();
+    }
+
+    uint32 index = 0;
+    for (member_citerator citr = m_memberSlots.begin(); citr != m_memberSlots.end(); ++citr, ++index)
+    {
+        Player* player = players[index];
         if (!player || !player->GetSession() || player->GetGroup() != this)
             continue;
         // guess size
@@ -551,13 +586,14 @@ void Group::SendUpdate()
         data << uint8(GetFlags(*citr));                     // group flags
         data << GetObjectGuid();                            // group guid
         data << uint32(GetMembersCount() - 1);
-        for (member_citerator citr2 = m_memberSlots.begin(); citr2 != m_memberSlots.end(); ++citr2)
+        uint32 index2 = 0;
+        for (member_citerator citr2 = m_memberSlots.begin(); citr2 != m_memberSlots.end(); ++citr2, ++index2)
         {
             if (citr->guid == citr2->guid)
                 continue;
             data << citr2->name;
             data << citr2->guid;
-            data << uint8(GetGroupMemberStatus(sObjectMgr.GetPlayer(citr2->guid)));
+            data << statuses[index2];
             data << uint8(citr2->group);                    // groupid
             data << uint8(GetFlags(*citr2));                // group flags
         }
@@ -583,13 +619,56 @@ void Group::UpdatePlayerOutOfRange(Player* pPlayer)
     if (pPlayer->GetGroupUpdateFlag() == GROUP_UPDATE_FLAG_NONE)
         return;
 
+    // built once for all members, the sessions only copy it
     WorldPacket data;
     pPlayer->GetSession()->BuildPartyMemberStatsChangedPacket(pPlayer, data);
+    ++m_updateBuilt;
 
+    uint32 sent = 0;
+    bool sentToAll = true;
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
+    {
         if (Player* player = itr->getSource())
-            if (player != pPlayer && !player->HaveAtClient(pPlayer))
+        {
+            if (player == pPlayer)
+                continue;
+
+            if (!player->HaveAtClient(pPlayer))
+            {
                 player->GetSession()->SendPacket(data);
+                ++sent;
+            }
+            else
+                sentToAll = false;
+        }
+    }
+
+    // values may only be left out later if every other member got them
+    if (sentToAll)
+        pPlayer->StoreSentGroupUpdateValues();
+    else
+        pPlayer->ForgetSentGroupUpdateValues();
+
+    m_updateSent += sent;
+    m_updateSentBytes += uint64(sent) * data.size();
+}
+
+void Group::GetUpdateStats(GroupUpdateStats& stats)
+{
+    stats.changedTicks = m_updateChangedTicks.load(std::memory_order_relaxed);
+    stats.built = m_updateBuilt.load(std::memory_order_relaxed);
+    stats.droppedFields = m_updateDroppedFields.load(std::memory_order_relaxed);
+    stats.sent = m_updateSent.load(std::memory_order_relaxed);
+    stats.sentBytes = m_updateSentBytes.load(std::memory_order_relaxed);
+}
+
+void Group::ResetUpdateStats()
+{
+    m_updateChangedTicks = 0;
+    m_updateBuilt = 0;
+    m_updateDroppedFields = 0;
+    m_updateSent = 0;
+    m_updateSentBytes = 0;
 }
 
 void Group::UpdatePlayerOnlineStatus(Player* player, bool online /*= true*/)
@@ -27,6 +27,8 @@
 #include "Server/DBCEnums.h"
 #include "Globals/SharedDefines.h"
 
+#include <atomic>
+
 class WorldSession;
 class Map;
 class BattleGround;
@@ -97,6 +99,24 @@ enum GroupUpdateFlags
 // 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,11,12,13,14,15,16,17,18,19
 static const uint8 GroupUpdateLength[GROUP_UPDATE_FLAGS_COUNT] = { 0, 2, 2, 2, 1, 2, 2, 2, 2, 4, 8, 8, 1, 2, 2, 2, 1, 2, 2, 8};
 
+// plain number fields, left out of an update while the group already knows their value
+#define GROUP_UPDATE_VALUES_COUNT         7
+static const uint32 GroupUpdateValueFlags[GROUP_UPDATE_VALUES_COUNT] =
+{
+    GROUP_UPDATE_FLAG_CUR_HP, GROUP_UPDATE_FLAG_MAX_HP, GROUP_UPDATE_FLAG_CUR_POWER, GROUP_UPDATE_FLAG_MAX_POWER,
+    GROUP_UPDATE_FLAG_LEVEL, GROUP_UPDATE_FLAG_ZONE, GROUP_UPDATE_FLAG_POSITION
+};
+
+/// SMSG_PARTY_MEMBER_STATS traffic summed over all groups
+struct GroupUpdateStats
+{
+    uint64 changedTicks;                                    // player updates with pending changes, each was a packet before the interval
+    uint64 built;                                           // packets built, each is sent to all out of range members
+    uint64 droppedFields;                                   // fields left out as unchanged
+    uint64 sent;
+    uint64 sentBytes;
+};
+
 struct InstanceGroupBind
 {
     DungeonPersistentState* state;
@@ -245,6 +265,11 @@ class Group
         void SendTargetIconList(WorldSession* session) const;
         void SendUpdate();
         void UpdatePlayerOutOfRange(Player* pPlayer);
+
+        static void GetUpdateStats(GroupUpdateStats& stats);
+        static void ResetUpdateStats();
+        static void AddChangedTick() { ++m_updateChangedTicks; }
+        static void AddDroppedFields(uint32 count) { m_updateDroppedFields += count; }
         void UpdatePlayerOnlineStatus(Player* player, bool online = true);
         void UpdateOfflineLeader(time_t time, uint32 delay);
         // ignore: GUID of player that will be ignored
@@ -360,5 +385,12 @@ class Group
         ObjectGuid          m_currentLooterGuid;
         BoundInstancesMap   m_boundInstances[MAX_DIFFICULTY];
         uint8*              m_subGroupsCounts;
+
+        // players update on the map threads
+        static std::atomic<uint64> m_updateChangedTicks;
+        static std::atomic<uint64> m_updateBuilt;
+        static std::atomic<uint64> m_updateDroppedFields;
+        static std::atomic<uint64> m_updateSent;
+        static std::atomic<uint64> m_updateSentBytes;
 };
 #endif
@@ -767,6 +767,9 @@ void WorldSession::HandleRequestPartyMemberStatsOpcode(WorldPacket& recv_data)
         return;
     }
 
+    // only the requester gets these values, later updates must not leave them out as known to the group
+    player->ForgetSentGroupUpdateValues();
+
     Pet* pet = player->GetPet();
 
     WorldPacket data(SMSG_PARTY_MEMBER_STATS_FULL, 4 + 2 + 2 + 2 + 1 + 2 * 6 + 8 + 1 + 8);
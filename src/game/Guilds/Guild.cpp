@@ -589,11 +589,11 @@ void Guild::BroadcastToGuild(WorldSession* session, const std::string& msg, uint
     WorldPacket data;
     ChatHandler::BuildChatPacket(data, CHAT_MSG_GUILD, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* pl = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+        Player* pl = *itr;
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+        if (pl->IsInWorld() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
             pl->GetSession()->SendPacket(data);
     }
 }
@@ -607,41 +607,55 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
     if (!player || !HasRankRight(player->GetRank(), GR_RIGHT_OFFCHATSPEAK))
         return;
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-    {
-        WorldPacket data;
-        ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
+    WorldPacket data;
+    ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-        Player* pl = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+    {
+        Player* pl = *itr;
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+        if (pl->IsInWorld() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
             pl->GetSession()->SendPacket(data);
     }
 }
 
 void Guild::BroadcastPacket(WorldPacket const& packet) const
 {
-    for (MemberList::const_iterator itr = members.cbegin(); itr != members.cend(); ++itr)
-    {
-        Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-        if (player)
-            player->GetSession()->SendPacket(packet);
-    }
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+        if ((*itr)->IsInWorld())
+            (*itr)->GetSession()->SendPacket(packet);
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket const& packet, uint32 rankId) const
 {
-    for (MemberList::const_iterator itr = members.cbegin(); itr != members.cend(); ++itr)
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        if (itr->second.RankId == rankId)
-        {
-            Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-            if (player)
-                player->GetSession()->SendPacket(packet);
-        }
+        Player* player = *itr;
+        if (!player->IsInWorld())
+            continue;
+
+        MemberList::const_iterator slot = members.find(player->GetGUIDLow());
+        if (slot != members.end() && slot->second.RankId == rankId)
+            player->GetSession()->SendPacket(packet);
     }
 }
 
+void Guild::AddOnlineMember(Player* player)
+{
+    if (std::find(m_onlineMembers.begin(), m_onlineMembers.end(), player) == m_onlineMembers.end())
+        m_onlineMembers.push_back(player);
+}
+
+void Guild::RemoveOnlineMember(Player* player)
+{
+    OnlineMemberList::iterator itr = std::find(m_onlineMembers.begin(), m_onlineMembers.end(), player);
+    if (itr == m_onlineMembers.end())
+        return;
+
+    *itr = m_onlineMembers.back();
+    m_onlineMembers.pop_back();
+}
+
 void Guild::CreateRank(std::string name_, uint32 rights)
 {
     if (m_Ranks.size() >= GUILD_RANKS_MAX_COUNT)
@@ -1026,13 +1040,13 @@ void Guild::DisplayGuildBankContentUpdate(uint8 TabId, int32 slot1, int32 slot2)
         AppendDisplayGuildBankSlot(data, tab, slot2);
     }
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-        if (!player)
+        Player* player = *itr;
+        if (!player->IsInWorld())
             continue;
 
-        if (!IsMemberHaveRights(itr->first, TabId, GUILD_BANK_RIGHT_VIEW_TAB))
+        if (!IsMemberHaveRights(player->GetGUIDLow(), TabId, GUILD_BANK_RIGHT_VIEW_TAB))
             continue;
 
         data.put<uint32>(rempos, uint32(GetMemberSlotWithdrawRem(player->GetGUIDLow(), TabId)));
@@ -1061,13 +1075,13 @@ void Guild::DisplayGuildBankContentUpdate(uint8 TabId, GuildItemPosCountVec cons
     for (GuildItemPosCountVec::const_iterator itr = slots.begin(); itr != slots.end(); ++itr)
         AppendDisplayGuildBankSlot(data, tab, itr->Slot);
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-        if (!player)
+        Player* player = *itr;
+        if (!player->IsInWorld())
             continue;
 
-        if (!IsMemberHaveRights(itr->first, TabId, GUILD_BANK_RIGHT_VIEW_TAB))
+        if (!IsMemberHaveRights(player->GetGUIDLow(), TabId, GUILD_BANK_RIGHT_VIEW_TAB))
             continue;
 
         data.put<uint32>(rempos, uint32(GetMemberSlotWithdrawRem(player->GetGUIDLow(), TabId)));
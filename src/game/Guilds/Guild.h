@@ -352,12 +352,15 @@ class Guild
         template<class Do>
         void BroadcastWorker(Do& _do, Player* except = nullptr)
         {
-            for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
-                if (Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
-                    if (player != except)
-                        _do(player);
+            for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+                if ((*itr)->IsInWorld() && *itr != except)
+                    _do(*itr);
         }
 
+        // members between login and logout, the broadcasts skip those not in world (teleporting between maps)
+        void AddOnlineMember(Player* player);
+        void RemoveOnlineMember(Player* player);
+
         void CreateRank(std::string name, uint32 rights);
         void DelRank();
         std::string GetRankName(uint32 rankId);
@@ -464,6 +467,9 @@ class Guild
 
         MemberList members;
 
+        typedef std::vector<Player*> OnlineMemberList;
+        OnlineMemberList m_onlineMembers;
+
         typedef std::vector<GuildBankTab*> TabListMap;
         TabListMap m_TabListMap;
 
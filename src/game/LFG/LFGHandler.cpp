@@ -27,11 +27,11 @@ static void AttemptJoin(Player* _player)
     if (!_player->m_lookingForGroup.canAutoJoin() || _player->GetGroup())
         return;
 
-    // TODO: Guard Player Map
-    HashMapHolder<Player>::MapType const& players = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = players.begin(); iter != players.end(); ++iter)
+    HashMapHolder<Player>::ObjectList players;
+    sObjectAccessor.GetPlayers(players);
+    for (HashMapHolder<Player>::ObjectList::const_iterator iter = players.begin(); iter != players.end(); ++iter)
     {
-        Player* plr = iter->second;
+        Player* plr = *iter;
 
         // skip enemies and self
         if (!plr || plr == _player || plr->GetTeam() != _player->GetTeam())
@@ -87,11 +87,11 @@ static void AttemptAddMore(Player* _player)
     if (!_player->m_lookingForGroup.more.canAutoJoin())
         return;
 
-    // TODO: Guard Player map
-    HashMapHolder<Player>::MapType const& players = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = players.begin(); iter != players.end(); ++iter)
+    HashMapHolder<Player>::ObjectList players;
+    sObjectAccessor.GetPlayers(players);
+    for (HashMapHolder<Player>::ObjectList::const_iterator iter = players.begin(); iter != players.end(); ++iter)
     {
-        Player* plr = iter->second;
+        Player* plr = *iter;
 
         // skip enemies and self
         if (!plr || plr == _player || plr->GetTeam() != _player->GetTeam())
@@ -259,11 +259,11 @@ void WorldSession::SendLfgResult(LfgType type, uint32 entry, LfgMode lfg_mode)
     data << uint32(0);                                      // count, placeholder
     data << uint32(0);                                      // count again, strange, placeholder
 
-    // TODO: Guard Player map
-    HashMapHolder<Player>::MapType const& players = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = players.begin(); iter != players.end(); ++iter)
+    HashMapHolder<Player>::ObjectList players;
+    sObjectAccessor.GetPlayers(players);
+    for (HashMapHolder<Player>::ObjectList::const_iterator iter = players.begin(); iter != players.end(); ++iter)
     {
-        Player* plr = iter->second;
+        Player* plr = *iter;
 
         if (!plr || plr->GetTeam() != _player->GetTeam())
             continue;
@@ -52,7 +52,7 @@ GridMap::GridMap(): m_gridIntHeightMultiplier(0)
     m_gridGetHeight = &GridMap::getHeightFromFlat;
     m_V9 = nullptr;
     m_V8 = nullptr;
-    memset(m_holes, 0, sizeof(m_holes));
+    m_holes = nullptr;
 
     // Liquid data
     m_liquidType    = 0;
@@ -76,130 +76,139 @@ bool GridMap::loadData(char* filename)
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    if (!m_file.Open(filename))
         return true;
 
-    fread(&header, sizeof(header), 1, in);
-    if (header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
-            header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)))
+    GridMapFileHeader const* header = getView<GridMapFileHeader>(0, 1);
+    if (header &&
+            header->mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
+            header->versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)))
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header->areaMapOffset && !loadAreaData(header->areaMapOffset, header->areaMapSize))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup holes data
-        if (header.holesOffset && !loadHolesData(in, header.holesOffset, header.holesSize))
+        if (header->holesOffset && !loadHolesData(header->holesOffset, header->holesSize))
         {
             sLog.outError("Error loading map holes data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header->heightMapOffset && !loadHeightData(header->heightMapOffset, header->heightMapSize))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup liquid data
-        if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header->liquidMapOffset && !loadGridMapLiquidData(header->liquidMapOffset, header->liquidMapSize))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
-    fclose(in);
+    unloadData();
     return false;
 }
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquidEntry;
-    delete[] m_liquidFlags;
-    delete[] m_liquid_map;
+    m_file.Close();
+    m_alignedCopies.clear();
 
     m_area_map = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
+    m_holes = nullptr;
     m_liquidEntry = nullptr;
     m_liquidFlags = nullptr;
     m_liquid_map  = nullptr;
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+template<typename T>
+T const* GridMap::getView(uint32 offset, uint32 count)
+{
+    size_t bytes = size_t(count) * sizeof(T);
+    if (offset > m_file.GetSize() || bytes > m_file.GetSize() - offset)
+        return nullptr;
+
+    uint8 const* data = m_file.GetData() + offset;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0)
+        return reinterpret_cast<T const*>(data);
+
+    // sections of older extractors are not padded
+    static_assert(alignof(T) <= alignof(uint32), "copy storage is not aligned for T");
+    m_alignedCopies.push_back(std::vector<uint32>((bytes + sizeof(uint32) - 1) / sizeof(uint32)));
+    memcpy(m_alignedCopies.back().data(), data, bytes);
+    return reinterpret_cast<T const*>(m_alignedCopies.back().data());
+}
+
+bool GridMap::loadAreaData(uint32 offset, uint32 /*size*/)
 {
-    GridMapAreaHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
+    GridMapAreaHeader const* header = getView<GridMapAreaHeader>(offset, 1);
+    if (!header || header->fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
         return false;
 
-    m_gridArea = header.gridArea;
-    if (!(header.flags & MAP_AREA_NO_AREA))
+    m_gridArea = header->gridArea;
+    if (!(header->flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        fread(m_area_map, sizeof(uint16), 16 * 16, in);
+        m_area_map = getView<uint16>(offset + sizeof(GridMapAreaHeader), 16 * 16);
+        if (!m_area_map)
+            return false;
     }
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint32 offset, uint32 /*size*/)
 {
-    GridMapHeightHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
+    GridMapHeightHeader const* header = getView<GridMapHeightHeader>(offset, 1);
+    if (!header || header->fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
         return false;
 
-    m_gridHeight = header.gridHeight;
-    if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
+    m_gridHeight = header->gridHeight;
+    if (!(header->flags & MAP_HEIGHT_NO_HEIGHT))
     {
-        if ((header.flags & MAP_HEIGHT_AS_INT16))
+        offset += sizeof(GridMapHeightHeader);
+
+        if ((header->flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
-            fread(m_uint16_V9, sizeof(uint16), 129 * 129, in);
-            fread(m_uint16_V8, sizeof(uint16), 128 * 128, in);
-            m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
+            m_uint16_V9 = getView<uint16>(offset, 129 * 129);
+            m_uint16_V8 = getView<uint16>(offset + 129 * 129 * sizeof(uint16), 128 * 128);
+            m_gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
-        else if ((header.flags & MAP_HEIGHT_AS_INT8))
+        else if ((header->flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
-            fread(m_uint8_V9, sizeof(uint8), 129 * 129, in);
-            fread(m_uint8_V8, sizeof(uint8), 128 * 128, in);
-            m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
+            m_uint8_V9 = getView<uint8>(offset, 129 * 129);
+            m_uint8_V8 = getView<uint8>(offset + 129 * 129 * sizeof(uint8), 128 * 128);
+            m_gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
-            fread(m_V9, sizeof(float), 129 * 129, in);
-            fread(m_V8, sizeof(float), 128 * 128, in);
+            m_V9 = getView<float>(offset, 129 * 129);
+            m_V8 = getView<float>(offset + 129 * 129 * sizeof(float), 128 * 128);
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
+
+        if (!m_V9 || !m_V8)
+            return false;
     }
     else
         m_gridGetHeight = &GridMap::getHeightFromFlat;
@@ -207,44 +216,44 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 size)
+bool GridMap::loadHolesData(uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-
-    if (fread(&m_holes, sizeof(m_holes), 1, in) != 1)
-        return false;
-    return true;
+    m_holes = getView<uint16>(offset, 16 * 16);
+    return m_holes != nullptr;
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(uint32 offset, uint32 /*size*/)
 {
-    GridMapLiquidHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
+    GridMapLiquidHeader const* header = getView<GridMapLiquidHeader>(offset, 1);
+    if (!header || header->fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
         return false;
 
-    m_liquidType    = header.liquidType;
-    m_liquid_offX   = header.offsetX;
-    m_liquid_offY   = header.offsetY;
-    m_liquid_width  = header.width;
-    m_liquid_height = header.height;
-    m_liquidLevel   = header.liquidLevel;
+    m_liquidType    = header->liquidType;
+    m_liquid_offX   = header->offsetX;
+    m_liquid_offY   = header->offsetY;
+    m_liquid_width  = header->width;
+    m_liquid_height = header->height;
+    m_liquidLevel   = header->liquidLevel;
 
-    if (!(header.flags & MAP_LIQUID_NO_TYPE))
+    offset += sizeof(GridMapLiquidHeader);
+
+    if (!(header->flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        fread(m_liquidEntry, sizeof(uint16), 16 * 16, in);
+        m_liquidEntry = getView<uint16>(offset, 16 * 16);
+        offset += 16 * 16 * sizeof(uint16);
+
+        m_liquidFlags = getView<uint8>(offset, 16 * 16);
+        offset += 16 * 16 * sizeof(uint8);
 
-        m_liquidFlags = new uint8[16 * 16];
-        fread(m_liquidFlags, sizeof(uint8), 16 * 16, in);
+        if (!m_liquidEntry || !m_liquidFlags)
+            return false;
     }
 
-    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
+    if (!(header->flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float [m_liquid_width * m_liquid_height];
-        fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in);
+        m_liquid_map = getView<float>(offset, m_liquid_width * m_liquid_height);
+        if (!m_liquid_map)
+            return false;
     }
 
     return true;
@@ -274,7 +283,10 @@ bool GridMap::isHole(int row, int col) const
     int holeRow = row % 8 / 2;
     int holeCol = (col - (cellCol * 8)) / 2;
 
-    uint16 hole = m_holes[cellRow][cellCol];
+    if (!m_holes)
+        return false;
+
+    uint16 hole = m_holes[cellRow * 16 + cellCol];
 
     return (hole & holetab_h[holeCol] & holetab_v[holeRow]) != 0;
 }
@@ -380,7 +392,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -448,7 +460,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
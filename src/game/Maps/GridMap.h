@@ -22,9 +22,11 @@
 #include "Platform/Define.h"
 #include "Policies/Singleton.h"
 #include "Maps/GridDefines.h"
+#include "MappedFile.h"
 
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 class Creature;
 class Unit;
@@ -113,31 +115,41 @@ struct GridMapLiquidData
     float depth_level;
 };
 
+/**
+ * Terrain of one grid, the arrays are read-only views into the memory mapped .map file.
+ *
+ * Loading a grid only maps the file, its pages are read on first access and shared
+ * with every other mapping of the file. Arrays not aligned for their type in files of
+ * older extractors are copied once.
+ */
 class GridMap
 {
     private:
 
-        uint16 m_holes[16][16];
+        MappedFile m_file;
+        std::vector<std::vector<uint32> > m_alignedCopies;
+
+        uint16 const* m_holes;                              // 16 * 16 cells, nullptr without holes
         uint32 m_flags;
 
         // Area data
         uint16 m_gridArea;
-        uint16* m_area_map;
+        uint16 const* m_area_map;
 
         // Height level data
         float m_gridHeight;
         float m_gridIntHeightMultiplier;
         union
         {
-            float* m_V9;
-            uint16* m_uint16_V9;
-            uint8* m_uint8_V9;
+            float const* m_V9;
+            uint16 const* m_uint16_V9;
+            uint8 const* m_uint8_V9;
         };
         union
         {
-            float* m_V8;
-            uint16* m_uint16_V8;
-            uint8* m_uint8_V8;
+            float const* m_V8;
+            uint16 const* m_uint16_V8;
+            uint8 const* m_uint8_V8;
         };
 
         // Liquid data
@@ -147,14 +159,17 @@ class GridMap
         uint8 m_liquid_width;
         uint8 m_liquid_height;
         float m_liquidLevel;
-        uint16* m_liquidEntry;
-        uint8* m_liquidFlags;
-        float* m_liquid_map;
-
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
-        bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+        uint16 const* m_liquidEntry;
+        uint8 const* m_liquidFlags;
+        float const* m_liquid_map;
+
+        template<typename T>
+        T const* getView(uint32 offset, uint32 count);
+
+        bool loadAreaData(uint32 offset, uint32 size);
+        bool loadHeightData(uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(uint32 offset, uint32 size);
+        bool loadHolesData(uint32 offset, uint32 size);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
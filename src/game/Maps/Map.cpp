@@ -34,10 +34,14 @@
 #include "Maps/MapPersistentStateMgr.h"
 #include "VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
+#include "MotionGenerators/PathCorridorCache.h"
 #include "Chat/Chat.h"
 #include "Weather/Weather.h"
 #include "Grids/ObjectGridLoader.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
+#include "Social/PlayerDirectory.h"
+#include "Guilds/Guild.h"
+#include "Guilds/GuildMgr.h"
 
 Map::~Map()
 {
@@ -78,7 +82,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
       m_activeNonPlayersIter(m_activeNonPlayers.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(nullptr), i_script_id(0)
+      i_data(nullptr), i_script_id(0),
+      m_pathCorridorCache(new PathCorridorCache())
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
@@ -200,6 +205,9 @@ void Map::RemoveFromGrid(Creature* obj, NGridType* grid, Cell const& cell)
 
 void Map::DeleteFromWorld(Player* pl)
 {
+    sPlayerDirectory.RemovePlayer(pl);
+    if (Guild* guild = sGuildMgr.GetGuildById(pl->GetGuildId()))
+        guild->RemoveOnlineMember(pl);
     sObjectAccessor.RemoveObject(pl);
     delete pl;
 }
@@ -445,90 +453,65 @@ bool Map::loaded(const GridPair& p) const
 
 void Map::Update(const uint32& t_diff)
 {
+    ProfileScope mapScope("map", i_id);
+
     m_dyn_tree.update(t_diff);
 
     /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if (plr && plr->IsInWorld())
+        ProfileScope profileScope("sessions");
+
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            WorldSession* pSession = plr->GetSession();
-            MapSessionFilter updater(pSession);
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+            {
+                WorldSession* pSession = plr->GetSession();
+                MapSessionFilter updater(pSession);
 
-            pSession->Update(updater);
+                pSession->Update(updater);
+            }
         }
     }
 
     /// update players at tick
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if (plr && plr->IsInWorld())
+        ProfileScope profileScope("players");
+
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            WorldObject::UpdateHelper helper(plr);
-            helper.Update(t_diff);
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+            {
+                WorldObject::UpdateHelper helper(plr);
+                helper.Update(t_diff);
+            }
         }
     }
 
     /// update active cells around players and active objects
-    resetMarkedCells();
-
-    MaNGOS::ObjectUpdater updater(t_diff);
-    // for creature
-    TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
-    // for pets
-    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
-
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
+        ProfileScope profileScope("cells");
 
-        if (!plr->IsInWorld() || !plr->IsPositionValid())
-            continue;
+        resetMarkedCells();
 
-        // lets update mobs/objects in ALL visible cells around player!
-        CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), GetVisibilityDistance());
+        MaNGOS::ObjectUpdater updater(t_diff);
+        // for creature
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+        // for pets
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::Remove don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
-            {
-                // marked cells are those that have been visited
-                // don't visit the same cell twice
-                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
-                {
-                    markCell(cell_id);
-                    CellPair pair(x, y);
-                    Cell cell(pair);
-                    cell.SetNoCreate();
-                    Visit(cell, grid_object_update);
-                    Visit(cell, world_object_update);
-                }
-            }
-        }
-    }
-
-    // non-player active objects
-    if (!m_activeNonPlayers.empty())
-    {
-        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
-        {
-            // skip not in world
-            WorldObject* obj = *m_activeNonPlayersIter;
-
-            // step before processing, in this case if Map::Remove remove next object we correctly
-            // step to next-next, and if we step to end() then newly added objects can wait next update.
-            ++m_activeNonPlayersIter;
+            Player* plr = m_mapRefIter->getSource();
 
-            if (!obj->IsInWorld() || !obj->IsPositionValid())
+            if (!plr->IsInWorld() || !plr->IsPositionValid())
                 continue;
 
             // lets update mobs/objects in ALL visible cells around player!
-            CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+            CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), GetVisibilityDistance());
 
             for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
             {
@@ -549,15 +532,59 @@ void Map::Update(const uint32& t_diff)
                 }
             }
         }
+
+        // non-player active objects
+        if (!m_activeNonPlayers.empty())
+        {
+            for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+            {
+                // skip not in world
+                WorldObject* obj = *m_activeNonPlayersIter;
+
+                // step before processing, in this case if Map::Remove remove next object we correctly
+                // step to next-next, and if we step to end() then newly added objects can wait next update.
+                ++m_activeNonPlayersIter;
+
+                if (!obj->IsInWorld() || !obj->IsPositionValid())
+                    continue;
+
+                // lets update mobs/objects in ALL visible cells around player!
+                CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+
+                for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+                {
+                    for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+                    {
+                        // marked cells are those that have been visited
+                        // don't visit the same cell twice
+                        uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                        if (!isCellMarked(cell_id))
+                        {
+                            markCell(cell_id);
+                            CellPair pair(x, y);
+                            Cell cell(pair);
+                            cell.SetNoCreate();
+                            Visit(cell, grid_object_update);
+                            Visit(cell, world_object_update);
+                        }
+                    }
+                }
+            }
+        }
     }
 
     // Send world objects and item update field changes
-    SendObjectUpdates();
+    {
+        ProfileScope profileScope("object updates");
+        SendObjectUpdates();
+    }
 
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
     {
+        ProfileScope profileScope("grid states");
+
         for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
         {
             NGridType* grid = i->getSource();
@@ -570,7 +597,10 @@ void Map::Update(const uint32& t_diff)
 
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
+    {
+        ProfileScope profileScope("scripts");
         ScriptsProcess();
+    }
 
     if (i_data)
         i_data->Update(t_diff);
@@ -2082,11 +2112,13 @@ float Map::GetHeight(float x, float y, float z) const
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.insert(mdl);
+    m_pathCorridorCache->Invalidate();
 }
 
 void Map::RemoveGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.remove(mdl);
+    m_pathCorridorCache->Invalidate();
 }
 
 bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
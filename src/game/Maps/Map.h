@@ -36,6 +36,7 @@
 #include "vmap/DynamicTree.h"
 
 #include <bitset>
+#include <memory>
 
 struct CreatureInfo;
 class Creature;
@@ -52,6 +53,7 @@ class BattleGround;
 class GridMap;
 class GameObjectModel;
 class WeatherSystem;
+class PathCorridorCache;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -281,6 +283,9 @@ class Map : public GridRefManager<NGridType>
         void RemoveGameObjectModel(const GameObjectModel& mdl);
         bool ContainsGameObjectModel(const GameObjectModel& mdl) const;
 
+        // Poly corridors shared by the units chasing the same target, dropped on dynamic collision changes
+        std::shared_ptr<PathCorridorCache> const& GetPathCorridorCache() const { return m_pathCorridorCache; }
+
         // Get Holder for Creature Linking
         CreatureLinkingHolder* GetCreatureLinkingHolder() { return &m_creatureLinkingHolder; }
 
@@ -392,6 +397,8 @@ class Map : public GridRefManager<NGridType>
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
 
+        std::shared_ptr<PathCorridorCache> m_pathCorridorCache;
+
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
 };
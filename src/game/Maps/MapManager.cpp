@@ -26,6 +26,7 @@
 #include "World/World.h"
 #include "Grids/CellImpl.h"
 #include "Globals/ObjectMgr.h"
+#include "MotionGenerators/PathFinderService.h"
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
@@ -56,6 +57,8 @@ MapManager::Initialize()
     if (num_threads > 0)
         m_updater.activate(num_threads);
 
+    sPathFinderService.Start(sWorld.getConfig(CONFIG_PATHFINDER_NUMTHREADS));
+
     InitMaxInstanceId();
 }
 
@@ -176,20 +179,28 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
     {
+        WorldUpdatePhaseTimer phaseTimer(WUPDATE_PHASE_MAPS);
+
+        for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+        {
+            if (m_updater.activated())
+                m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
+            else
+                iter->second->Update((uint32) i_timer.GetCurrent());
+        }
         if (m_updater.activated())
-            m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
-        else
-            iter->second->Update((uint32) i_timer.GetCurrent());
+            m_updater.wait();
     }
-    if (m_updater.activated())
-        m_updater.wait();
 
-    for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
     {
-        WorldObject::UpdateHelper helper((*iter));
-        helper.Update((uint32)i_timer.GetCurrent());
+        WorldUpdatePhaseTimer phaseTimer(WUPDATE_PHASE_TRANSPORTS);
+
+        for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
+        {
+            WorldObject::UpdateHelper helper((*iter));
+            helper.Update((uint32)i_timer.GetCurrent());
+        }
     }
 
     // remove all maps which can be unloaded
@@ -237,6 +248,9 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    // workers may still search the nav meshes of the maps
+    sPathFinderService.Stop();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->UnloadAll(true);
 
@@ -67,6 +67,14 @@ void MapUpdater::deactivate()
 
 void MapUpdater::wait()
 {
+    // run queued updates on the waiting thread too instead of idling until the workers are done
+    MapUpdateRequest* request = nullptr;
+    while (_queue.Pop(request))
+    {
+        request->call();
+        delete request;
+    }
+
     std::unique_lock<std::mutex> lock(_lock);
 
     while (pending_requests > 0)
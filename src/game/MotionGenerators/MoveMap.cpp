@@ -131,11 +131,20 @@ namespace MMAP
         // if we had, tiles in MMapData->mmapLoadedTiles, their actual data is lost!
     }
 
+    uint32 MMapManager::getLoadedMapsCount() const
+    {
+        boost::shared_lock<boost::shared_mutex> lock(mapsLock);
+        return loadedMMaps.size();
+    }
+
     bool MMapManager::loadMapData(uint32 mapId)
     {
         // we already have this map loaded?
-        if (loadedMMaps.find(mapId) != loadedMMaps.end())
-            return true;
+        {
+            boost::shared_lock<boost::shared_mutex> lock(mapsLock);
+            if (loadedMMaps.find(mapId) != loadedMMaps.end())
+                return true;
+        }
 
         // load and init dtNavMesh - read parameters from file
         uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i.mmap") + 1;
@@ -170,10 +179,15 @@ namespace MMAP
 
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMapData: Loaded %03i.mmap", mapId);
 
-        // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
-        mmap_data->mmapLoadedTiles.clear();
+        // store inside our map list, another instance of the map may have been faster
+        boost::unique_lock<boost::shared_mutex> lock(mapsLock);
+        if (loadedMMaps.find(mapId) != loadedMMaps.end())
+        {
+            dtFreeNavMesh(mesh);
+            return true;
+        }
 
+        MMapData* mmap_data = new MMapData(mesh, ++nextGeneration);
         loadedMMaps.insert(std::pair<uint32, MMapData*>(mapId, mmap_data));
         return true;
     }
@@ -189,18 +203,6 @@ namespace MMAP
         if (!loadMapData(mapId))
             return false;
 
-        // get this mmap data
-        MMapData* mmap = loadedMMaps[mapId];
-        MANGOS_ASSERT(mmap->navMesh);
-
-        // check if we already have this tile loaded
-        uint32 packedGridPos = packTileID(x, y);
-        if (mmap->mmapLoadedTiles.find(packedGridPos) != mmap->mmapLoadedTiles.end())
-        {
-            sLog.outError("MMAP:loadMap: Asked to load already loaded navmesh tile. %03u%02i%02i.mmtile", mapId, x, y);
-            return false;
-        }
-
         // load this tile :: mmaps/MMMXXYY.mmtile
         uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i%02i%02i.mmtile") + 1;
         char* fileName = new char[pathLen];
@@ -241,12 +243,38 @@ namespace MMAP
         if (!result)
         {
             sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
+            dtFree(data);
             fclose(file);
             return false;
         }
 
         fclose(file);
 
+        // the file is read without locks, pathfinding workers only wait for the tile insertion
+        boost::shared_lock<boost::shared_mutex> mapsGuard(mapsLock);
+
+        // get this mmap data
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+        {
+            dtFree(data);
+            return false;
+        }
+
+        MMapData* mmap = itr->second;
+        MANGOS_ASSERT(mmap->navMesh);
+
+        boost::unique_lock<boost::shared_mutex> tileGuard(mmap->tileLock);
+
+        // check if we already have this tile loaded
+        uint32 packedGridPos = packTileID(x, y);
+        if (mmap->mmapLoadedTiles.find(packedGridPos) != mmap->mmapLoadedTiles.end())
+        {
+            sLog.outError("MMAP:loadMap: Asked to load already loaded navmesh tile. %03u%02i%02i.mmtile", mapId, x, y);
+            dtFree(data);
+            return false;
+        }
+
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
@@ -267,6 +295,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
+        boost::shared_lock<boost::shared_mutex> mapsGuard(mapsLock);
+
         // check if we have this map loaded
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
@@ -276,6 +306,7 @@ namespace MMAP
         }
 
         MMapData* mmap = loadedMMaps[mapId];
+        boost::unique_lock<boost::shared_mutex> tileGuard(mmap->tileLock);
 
         // check if we have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
@@ -311,6 +342,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
+        boost::unique_lock<boost::shared_mutex> lock(mapsLock);
+
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
             // file may not exist, therefore not loaded
@@ -343,6 +376,8 @@ namespace MMAP
 
     bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
     {
+        boost::unique_lock<boost::shared_mutex> lock(mapsLock);
+
         // check if we have this map loaded
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
@@ -369,6 +404,8 @@ namespace MMAP
 
     dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
+        boost::shared_lock<boost::shared_mutex> lock(mapsLock);
+
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
             return nullptr;
 
@@ -377,6 +414,21 @@ namespace MMAP
 
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
+        {
+            boost::shared_lock<boost::shared_mutex> lock(mapsLock);
+
+            MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+            if (itr == loadedMMaps.end())
+                return nullptr;
+
+            NavMeshQuerySet::const_iterator qItr = itr->second->navMeshQueries.find(instanceId);
+            if (qItr != itr->second->navMeshQueries.end())
+                return qItr->second;
+        }
+
+        // instances of one map run on different map threads
+        boost::unique_lock<boost::shared_mutex> lock(mapsLock);
+
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
             return nullptr;
 
@@ -400,4 +452,25 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    // ######################## NavMeshReadGuard ########################
+    NavMeshReadGuard::NavMeshReadGuard(MMapManager* manager, uint32 mapId) : m_manager(manager), m_data(nullptr)
+    {
+        m_manager->mapsLock.lock_shared();
+
+        MMapDataSet::const_iterator itr = m_manager->loadedMMaps.find(mapId);
+        if (itr != m_manager->loadedMMaps.end())
+        {
+            m_data = itr->second;
+            m_data->tileLock.lock_shared();
+        }
+    }
+
+    NavMeshReadGuard::~NavMeshReadGuard()
+    {
+        if (m_data)
+            m_data->tileLock.unlock_shared();
+
+        m_manager->mapsLock.unlock_shared();
+    }
 }
@@ -24,6 +24,11 @@
 #include "../../dep/recastnavigation/Detour/Include/DetourNavMesh.h"
 #include "../../dep/recastnavigation/Detour/Include/DetourNavMeshQuery.h"
 
+#include <atomic>
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
 class Unit;
 
 //  memory management
@@ -46,7 +51,7 @@ namespace MMAP
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
+        MMapData(dtNavMesh* mesh, uint32 gen) : navMesh(mesh), generation(gen) {}
         ~MMapData()
         {
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
@@ -61,6 +66,9 @@ namespace MMAP
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+
+        uint32 generation;                  // tells apart the meshes of one map over unload and reload
+        boost::shared_mutex tileLock;       // held exclusive while tiles are added or removed
     };
 
 
@@ -71,7 +79,7 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), nextGeneration(0) {}
             ~MMapManager();
 
             bool loadMap(uint32 mapId, int32 x, int32 y);
@@ -84,13 +92,38 @@ namespace MMAP
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
-            uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+            uint32 getLoadedMapsCount() const;
         private:
+            friend class NavMeshReadGuard;
+
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y) const;
 
             MMapDataSet loadedMMaps;
-            uint32 loadedTiles;
+            std::atomic<uint32> loadedTiles;
+            uint32 nextGeneration;
+
+            // guards loadedMMaps and the instance queries, tiles are guarded by MMapData::tileLock
+            mutable boost::shared_mutex mapsLock;
+    };
+
+    // read access to a map's nav mesh, no tile is added or removed while the guard lives
+    // used by the pathfinding workers, which search the mesh outside of the map update
+    class NavMeshReadGuard
+    {
+        public:
+            NavMeshReadGuard(MMapManager* manager, uint32 mapId);
+            ~NavMeshReadGuard();
+
+            dtNavMesh const* GetNavMesh() const { return m_data ? m_data->navMesh : nullptr; }
+            uint32 GetGeneration() const { return m_data ? m_data->generation : 0; }
+
+        private:
+            NavMeshReadGuard(NavMeshReadGuard const&);
+            NavMeshReadGuard& operator=(NavMeshReadGuard const&);
+
+            MMapManager* m_manager;
+            MMapData* m_data;
     };
 
     // static class
@@ -0,0 +1,170 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MotionGenerators/PathCorridorCache.h"
+#include "Timer.h"
+
+#include "../recastnavigation/Detour/Include/DetourCommon.h"
+
+#include <cmath>
+
+std::atomic<uint64> PathCorridorCache::m_hits(0);
+std::atomic<uint64> PathCorridorCache::m_misses(0);
+
+PathCorridorCache::PathCorridorCache()
+{
+}
+
+PathCorridorCache::Key PathCorridorCache::MakeKey(dtQueryFilter const& filter, dtPolyRef endPoly, float const* startPoint)
+{
+    // detour points are {y, z, x}
+    Key key;
+    key.endPoly = endPoly;
+    key.cellX = int32(floor(startPoint[2] / PATH_CORRIDOR_CELL_SIZE));
+    key.cellY = int32(floor(startPoint[0] / PATH_CORRIDOR_CELL_SIZE));
+    key.flags = uint32(filter.getIncludeFlags()) | (uint32(filter.getExcludeFlags()) << 16);
+    return key;
+}
+
+bool PathCorridorCache::IsFresh(Corridor const& corridor, float const* endPoint, uint32 now)
+{
+    if (WorldTimer::getMSTimeDiff(corridor.time, now) > PATH_CORRIDOR_MAX_AGE)
+        return false;
+
+    return dtVdistSqr(corridor.end, endPoint) <= PATH_CORRIDOR_MAX_DRIFT * PATH_CORRIDOR_MAX_DRIFT;
+}
+
+bool PathCorridorCache::Find(dtQueryFilter const& filter, dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                             dtPolyRef* path, uint32& pathLength)
+{
+    Key key = MakeKey(filter, endPoly, startPoint);
+    uint32 now = WorldTimer::getMSTime();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    SlotMap::const_iterator itr = m_slots.find(key);
+    if (itr != m_slots.end())
+    {
+        Slot const& slot = itr->second;
+        for (uint32 i = 0; i < slot.count; ++i)
+        {
+            Corridor const& corridor = slot.corridors[i];
+            if (!IsFresh(corridor, endPoint, now))
+                continue;
+
+            for (uint32 start = 0; start < corridor.length; ++start)
+            {
+                if (corridor.polys[start] != startPoly)
+                    continue;
+
+                // the corridor ends at endPoly, its suffix from our start polygon is the optimal path as well
+                pathLength = corridor.length - start;
+                memcpy(path, corridor.polys + start, pathLength * sizeof(dtPolyRef));
+                ++m_hits;
+                return true;
+            }
+        }
+    }
+
+    ++m_misses;
+    return false;
+}
+
+void PathCorridorCache::Store(dtQueryFilter const& filter, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                              dtPolyRef const* path, uint32 pathLength)
+{
+    Key key = MakeKey(filter, endPoly, startPoint);
+    uint32 now = WorldTimer::getMSTime();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (m_slots.size() >= PATH_CORRIDOR_MAX_KEYS && m_slots.find(key) == m_slots.end())
+    {
+        RemoveStale(now);
+
+        // all fresh, many targets are chased at once on this map
+        if (m_slots.size() >= PATH_CORRIDOR_MAX_KEYS)
+            m_slots.clear();
+    }
+
+    Slot& slot = m_slots[key];
+
+    // a corridor to a moved target is replaced first
+    uint32 index = slot.count;
+    for (uint32 i = 0; i < slot.count; ++i)
+    {
+        if (!IsFresh(slot.corridors[i], endPoint, now))
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == PATH_CORRIDORS_PER_KEY)
+    {
+        index = slot.next;
+        slot.next = (slot.next + 1) % PATH_CORRIDORS_PER_KEY;
+    }
+    else if (index == slot.count)
+        ++slot.count;
+
+    Corridor& corridor = slot.corridors[index];
+    corridor.time = now;
+    dtVcopy(corridor.end, endPoint);
+    corridor.length = pathLength;
+    memcpy(corridor.polys, path, pathLength * sizeof(dtPolyRef));
+}
+
+void PathCorridorCache::RemoveStale(uint32 now)
+{
+    for (SlotMap::iterator itr = m_slots.begin(); itr != m_slots.end();)
+    {
+        Slot const& slot = itr->second;
+
+        bool fresh = false;
+        for (uint32 i = 0; i < slot.count && !fresh; ++i)
+            fresh = WorldTimer::getMSTimeDiff(slot.corridors[i].time, now) <= PATH_CORRIDOR_MAX_AGE;
+
+        if (fresh)
+            ++itr;
+        else
+            itr = m_slots.erase(itr);
+    }
+}
+
+void PathCorridorCache::Invalidate()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_slots.clear();
+}
+
+uint32 PathCorridorCache::GetCorridorCount() const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    uint32 count = 0;
+    for (SlotMap::const_iterator itr = m_slots.begin(); itr != m_slots.end(); ++itr)
+        count += itr->second.count;
+    return count;
+}
+
+void PathCorridorCache::ResetStats()
+{
+    m_hits = 0;
+    m_misses = 0;
+}
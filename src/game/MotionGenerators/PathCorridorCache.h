@@ -0,0 +1,116 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PATHCORRIDORCACHE_H
+#define MANGOS_PATHCORRIDORCACHE_H
+
+#include "Common.h"
+#include "MotionGenerators/PathFinder.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#define PATH_CORRIDOR_CELL_SIZE         16.0f               // edge of the start regions in yards
+#define PATH_CORRIDOR_MAX_AGE           1000                // ms a corridor is handed out
+#define PATH_CORRIDOR_MAX_DRIFT         4.0f                // the target moved further than this from the stored end, corridor is stale
+#define PATH_CORRIDORS_PER_KEY          4                   // corridors of different start polygons within one start region
+#define PATH_CORRIDOR_MAX_KEYS          256
+
+/**
+ * Per map cache of poly corridors towards recently searched destinations.
+ *
+ * Creatures chasing the same target from the same start region mostly walk the same polygons,
+ * so a search first looks for a fresh corridor ending at its destination polygon and containing
+ * its start polygon and cuts its own path out of it. Only complete paths are stored.
+ * Everything is dropped when the dynamic collision of the map changes (doors, gameobject models).
+ */
+class PathCorridorCache
+{
+    public:
+        PathCorridorCache();
+
+        /// Fills the corridor from startPoly to endPoly if a fresh one is known
+        bool Find(dtQueryFilter const& filter, dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                  dtPolyRef* path, uint32& pathLength);
+        void Store(dtQueryFilter const& filter, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                   dtPolyRef const* path, uint32 pathLength);
+
+        void Invalidate();
+
+        uint32 GetCorridorCount() const;
+
+        /// Summed over all maps
+        static uint64 GetHits() { return m_hits.load(std::memory_order_relaxed); }
+        static uint64 GetMisses() { return m_misses.load(std::memory_order_relaxed); }
+        static void ResetStats();
+
+    private:
+        struct Key
+        {
+            bool operator==(Key const& other) const
+            {
+                return endPoly == other.endPoly && cellX == other.cellX && cellY == other.cellY && flags == other.flags;
+            }
+
+            dtPolyRef endPoly;
+            int32 cellX;
+            int32 cellY;
+            uint32 flags;                                   // include and exclude flags of the search filter
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(Key const& key) const
+            {
+                return size_t(key.endPoly * 0x9E3779B97F4A7C15ULL) ^ (size_t(key.cellX) << 20) ^ (size_t(key.cellY) << 8) ^ key.flags;
+            }
+        };
+
+        struct Corridor
+        {
+            uint32 time;                                    // of the search, WorldTimer::getMSTime
+            float end[VERTEX_SIZE];
+            dtPolyRef polys[MAX_PATH_LENGTH];
+            uint32 length;
+        };
+
+        struct Slot
+        {
+            Slot() : count(0), next(0) {}
+
+            Corridor corridors[PATH_CORRIDORS_PER_KEY];
+            uint32 count;
+            uint32 next;                                    // replaced by the next store once all are used
+        };
+
+        typedef std::unordered_map<Key, Slot, KeyHash> SlotMap;
+
+        static Key MakeKey(dtQueryFilter const& filter, dtPolyRef endPoly, float const* startPoint);
+        static bool IsFresh(Corridor const& corridor, float const* endPoint, uint32 now);
+
+        void RemoveStale(uint32 now);
+
+        mutable std::mutex m_lock;
+        SlotMap m_slots;
+
+        static std::atomic<uint64> m_hits;
+        static std::atomic<uint64> m_misses;
+};
+
+#endif
@@ -20,6 +20,8 @@
 #include "Maps/GridMap.h"
 #include "Entities/Creature.h"
 #include "MotionGenerators/PathFinder.h"
+#include "MotionGenerators/PathCorridorCache.h"
+#include "Maps/Map.h"
 #include "Log.h"
 #include "World/World.h"
 
@@ -30,16 +32,19 @@
 PathFinder::PathFinder(const Unit* owner) :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH),
-    m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr)
+    m_sourceUnit(owner), m_sourceGuidLow(owner->GetGUIDLow()), m_mapId(owner->GetMapId()),
+    m_navMesh(nullptr), m_navMeshQuery(nullptr),
+    m_isCreature(owner->GetTypeId() == TYPEID_UNIT), m_canSwim(false), m_canFly(false),
+    m_liquidStatePrepared(false), m_startUnderWater(false), m_endUnderWater(false), m_onWorker(false)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
-    uint32 mapId = m_sourceUnit->GetMapId();
-    if (MMAP::MMapFactory::IsPathfindingEnabled(mapId, owner))
+    if (MMAP::MMapFactory::IsPathfindingEnabled(m_mapId, owner))
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        m_navMesh = mmap->GetNavMesh(mapId);
-        m_navMeshQuery = mmap->GetNavMeshQuery(mapId, m_sourceUnit->GetInstanceId());
+        m_navMesh = mmap->GetNavMesh(m_mapId);
+        m_navMeshQuery = mmap->GetNavMeshQuery(m_mapId, m_sourceUnit->GetInstanceId());
+        m_corridorCache = m_sourceUnit->GetMap()->GetPathCorridorCache();
     }
 
     createFilter();
@@ -47,11 +52,75 @@ PathFinder::PathFinder(const Unit* owner) :
 
 PathFinder::~PathFinder()
 {
-    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceUnit->GetGUIDLow());
+    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceGuidLow);
 }
 
 bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest)
 {
+    // other instances of the map may load tiles meanwhile
+    MMAP::NavMeshReadGuard guard(MMAP::MMapFactory::createOrGetMMapManager(), m_mapId);
+
+    bool needPolyPath;
+    if (!initCalculation(destX, destY, destZ, forceDest, needPolyPath))
+        return false;
+
+    if (needPolyPath)
+        BuildPolyPath(m_startPosition, m_endPosition);
+
+    return true;
+}
+
+bool PathFinder::prepareCalculation(float destX, float destY, float destZ, bool forceDest)
+{
+    MMAP::NavMeshReadGuard guard(MMAP::MMapFactory::createOrGetMMapManager(), m_mapId);
+
+    bool needPolyPath;
+    if (!initCalculation(destX, destY, destZ, forceDest, needPolyPath) || !needPolyPath)
+        return false;
+
+    // the worker can't look into the terrain, take what BuildPolyPath may ask for
+    if (m_isCreature)
+    {
+        m_startUnderWater = m_sourceUnit->GetTerrain()->IsUnderWater(m_startPosition.x, m_startPosition.y, m_startPosition.z);
+        m_endUnderWater = m_sourceUnit->GetTerrain()->IsUnderWater(m_endPosition.x, m_endPosition.y, m_endPosition.z);
+    }
+
+    m_liquidStatePrepared = true;
+    return true;
+}
+
+void PathFinder::computePath(const dtNavMesh* navMesh, const dtNavMeshQuery* navMeshQuery)
+{
+    m_onWorker = true;
+    m_navMesh = navMesh;
+    m_navMeshQuery = navMeshQuery;
+
+    // the map's mmap was unloaded meanwhile
+    if (!m_navMesh || !m_navMeshQuery)
+    {
+        BuildShortcut();
+        m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return;
+    }
+
+    BuildPolyPath(m_startPosition, m_endPosition);
+}
+
+void PathFinder::finishCalculation(const PathFinder& job)
+{
+    memcpy(m_pathPolyRefs, job.m_pathPolyRefs, job.m_polyLength * sizeof(dtPolyRef));
+    m_polyLength = job.m_polyLength;
+    m_pathPoints = job.m_pathPoints;
+    m_type = job.m_type;
+    m_actualEndPosition = job.m_actualEndPosition;
+
+    NormalizePath();
+}
+
+bool PathFinder::initCalculation(float destX, float destY, float destZ, bool forceDest, bool& needPolyPath)
+{
+    needPolyPath = false;
+
     if (!MaNGOS::IsValidMapCoord(destX, destY, destZ))
         return false;
 
@@ -67,6 +136,13 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
     setEndPosition(dest);
 
     m_forceDestination = forceDest;
+    m_liquidStatePrepared = false;
+
+    if (m_isCreature)
+    {
+        m_canSwim = ((Creature*)m_sourceUnit)->CanSwim();
+        m_canFly = ((Creature*)m_sourceUnit)->CanFly();
+    }
 
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::calculate() for %u \n", m_sourceUnit->GetGUIDLow());
 
@@ -82,7 +158,7 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
 
     updateFilter();
 
-    BuildPolyPath(start, dest);
+    needPolyPath = true;
     return true;
 }
 
@@ -174,14 +250,14 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: (startPoly == 0 || endPoly == 0)\n");
         BuildShortcut();
 
-        if (m_sourceUnit->GetTypeId() == TYPEID_UNIT)
+        if (m_isCreature)
         {
             // Check for swimming or flying shortcut
-            if ((startPoly == INVALID_POLYREF && m_sourceUnit->GetTerrain()->IsUnderWater(startPos.x, startPos.y, startPos.z)) ||
-                    (endPoly == INVALID_POLYREF && m_sourceUnit->GetTerrain()->IsUnderWater(endPos.x, endPos.y, endPos.z)))
-                m_type = ((Creature*)m_sourceUnit)->CanSwim() ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
+            if ((startPoly == INVALID_POLYREF && isUnderWater(startPos, true)) ||
+                    (endPoly == INVALID_POLYREF && isUnderWater(endPos, false)))
+                m_type = m_canSwim ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
             else
-                m_type = ((Creature*)m_sourceUnit)->CanFly() ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
+                m_type = m_canFly ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
         }
         else
             m_type = PATHFIND_NOPATH;
@@ -196,21 +272,19 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: farFromPoly distToStartPoly=%.3f distToEndPoly=%.3f\n", distToStartPoly, distToEndPoly);
 
         bool buildShotrcut = false;
-        if (m_sourceUnit->GetTypeId() == TYPEID_UNIT)
+        if (m_isCreature)
         {
-            Creature* owner = (Creature*)m_sourceUnit;
-
-            Vector3 p = (distToStartPoly > 7.0f) ? startPos : endPos;
-            if (m_sourceUnit->GetTerrain()->IsUnderWater(p.x, p.y, p.z))
+            bool farFromStart = distToStartPoly > 7.0f;
+            if (isUnderWater(farFromStart ? startPos : endPos, farFromStart))
             {
                 DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: underWater case\n");
-                if (owner->CanSwim())
+                if (m_canSwim)
                     buildShotrcut = true;
             }
             else
             {
                 DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: flying case\n");
-                if (owner->CanFly())
+                if (m_canFly)
                     buildShotrcut = true;
             }
         }
@@ -269,7 +343,7 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
                 sLog.outError("Invalid poly ref in BuildPolyPath. polyLength: %u, pathStartIndex: %u,"
                     " startPos: %s, endPos: %s, mapId: %u",
                     m_polyLength, pathStartIndex, startPos.toString().c_str(), endPos.toString().c_str(),
-                    m_sourceUnit->GetMapId());
+                    m_mapId);
                 break;
             }
 
@@ -356,7 +430,7 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
             // this is probably an error state, but we'll leave it
             // and hopefully recover on the next Update
             // we still need to copy our preffix
-            sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
+            sLog.outError("%u's Path Build failed: 0 length path", m_sourceGuidLow);
         }
 
         DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u \n", m_polyLength, prefixPolyLength, suffixPolyLength);
@@ -375,23 +449,34 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         // free and invalidate old path data
         clear();
 
-        dtResult = m_navMeshQuery->findPath(
-                       startPoly,          // start polygon
-                       endPoly,            // end polygon
-                       startPoint,         // start position
-                       endPoint,           // end position
-                       &m_filter,           // polygon search filter
-                       m_pathPolyRefs,     // [out] path
-                       (int*)&m_polyLength,
-                       MAX_PATH_LENGTH);   // max number of polygons in output path
-
-        if (!m_polyLength || dtStatusFailed(dtResult))
+        // other units chasing the same target may have searched this corridor already
+        if (m_corridorCache && m_corridorCache->Find(m_filter, startPoly, endPoly, startPoint, endPoint, m_pathPolyRefs, m_polyLength))
         {
-            // only happens if we passed bad data to findPath(), or navmesh is messed up
-            sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
-            BuildShortcut();
-            m_type = PATHFIND_NOPATH;
-            return;
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: shared corridor of %u polys\n", m_polyLength);
+        }
+        else
+        {
+            dtResult = m_navMeshQuery->findPath(
+                           startPoly,          // start polygon
+                           endPoly,            // end polygon
+                           startPoint,         // start position
+                           endPoint,           // end position
+                           &m_filter,           // polygon search filter
+                           m_pathPolyRefs,     // [out] path
+                           (int*)&m_polyLength,
+                           MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            if (!m_polyLength || dtStatusFailed(dtResult))
+            {
+                // only happens if we passed bad data to findPath(), or navmesh is messed up
+                sLog.outError("%u's Path Build failed: 0 length path", m_sourceGuidLow);
+                BuildShortcut();
+                m_type = PATHFIND_NOPATH;
+                return;
+            }
+
+            if (m_corridorCache && m_pathPolyRefs[m_polyLength - 1] == endPoly)
+                m_corridorCache->Store(m_filter, endPoly, startPoint, endPoint, m_pathPolyRefs, m_polyLength);
         }
     }
 
@@ -548,6 +633,10 @@ void PathFinder::NormalizePath()
     if (!sWorld.getConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z))
         return;
 
+    // the unit's map can only be asked on the map thread
+    if (m_onWorker)
+        return;
+
     for (uint32 i = 0; i < m_pathPoints.size(); ++i)
         m_sourceUnit->UpdateAllowedPositionZ(m_pathPoints[i].x, m_pathPoints[i].y, m_pathPoints[i].z);
 }
@@ -612,6 +701,14 @@ void PathFinder::updateFilter()
     }
 }
 
+bool PathFinder::isUnderWater(const Vector3& p, bool start) const
+{
+    if (m_liquidStatePrepared)
+        return start ? m_startUnderWater : m_endUnderWater;
+
+    return m_sourceUnit->GetTerrain()->IsUnderWater(p.x, p.y, p.z);
+}
+
 NavTerrain PathFinder::getNavTerrain(float x, float y, float z) const
 {
     GridMapLiquidData data;
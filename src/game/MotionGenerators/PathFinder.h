@@ -25,10 +25,13 @@
 
 #include "Movement/MoveSplineInitArgs.h"
 
+#include <memory>
+
 using Movement::Vector3;
 using Movement::PointsArray;
 
 class Unit;
+class PathCorridorCache;
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -68,6 +71,14 @@ class PathFinder
         // return: true if new path was calculated, false otherwise (no change needed)
         bool calculate(float destX, float destY, float destZ, bool forceDest = false);
 
+        // Asynchronous calculation, see PathFinderService
+        // return: true if the path still has to be built by computePath on a copy, false if it is done already
+        bool prepareCalculation(float destX, float destY, float destZ, bool forceDest = false);
+        // builds the prepared path without touching the unit or the terrain, may run outside the map update
+        void computePath(const dtNavMesh* navMesh, const dtNavMeshQuery* navMeshQuery);
+        // takes over the path built by job, which was prepared with the same options
+        void finishCalculation(const PathFinder& job);
+
         // option setters - use optional
         void setUseStrightPath(bool useStraightPath) { m_useStraightPath = useStraightPath; };
         void setPathLengthLimit(float distance) { m_pointPathLimit = std::min<uint32>(uint32(distance / SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); };
@@ -81,6 +92,8 @@ class PathFinder
         PathType getPathType() const { return m_type; }
 
     private:
+        friend class PathFinderService;
+        friend struct PathRequestKey;
 
         dtPolyRef      m_pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
         uint32         m_polyLength;                      // number of polygons in the path
@@ -97,15 +110,30 @@ class PathFinder
         Vector3        m_actualEndPosition;// {x, y, z} of the closest possible point to given destination
 
         const Unit* const       m_sourceUnit;       // the unit that is moving
+        uint32                  m_sourceGuidLow;    // for logging from the pathfinding workers
+        uint32                  m_mapId;
         const dtNavMesh*        m_navMesh;          // the nav mesh
         const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
+        std::shared_ptr<PathCorridorCache> m_corridorCache; // of the unit's map, kept alive for pending worker searches
+
+        // state of the unit for the path searched on a worker, taken by prepareCalculation
+        bool           m_isCreature;
+        bool           m_canSwim;
+        bool           m_canFly;
+        bool           m_liquidStatePrepared;  // set when the underwater state of both ends is known
+        bool           m_startUnderWater;
+        bool           m_endUnderWater;
+        bool           m_onWorker;          // heights are normalized by finishCalculation on the map thread
+
         void setStartPosition(const Vector3& point) { m_startPosition = point; }
         void setEndPosition(const Vector3& point) { m_actualEndPosition = point; m_endPosition = point; }
         void setActualEndPosition(const Vector3& point) { m_actualEndPosition = point; }
         void NormalizePath();
+        bool initCalculation(float destX, float destY, float destZ, bool forceDest, bool& needPolyPath);
+        bool isUnderWater(const Vector3& p, bool start) const;
 
         void clear()
         {
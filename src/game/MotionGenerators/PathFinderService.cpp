@@ -0,0 +1,308 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MotionGenerators/PathFinderService.h"
+#include "MotionGenerators/MoveMap.h"
+#include "Log.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(PathFinderService);
+
+enum PathRequestOptions
+{
+    PATH_REQUEST_FORCE_DEST         = 0x01,
+    PATH_REQUEST_STRAIGHT_PATH      = 0x02,
+    PATH_REQUEST_CREATURE           = 0x04,
+    PATH_REQUEST_CAN_SWIM           = 0x08,
+    PATH_REQUEST_CAN_FLY            = 0x10,
+    PATH_REQUEST_START_UNDERWATER   = 0x20,
+    PATH_REQUEST_END_UNDERWATER     = 0x40,
+};
+
+PathRequestKey::PathRequestKey(PathFinder const& path) :
+    mapId(path.m_mapId),
+    includeFlags(path.m_filter.getIncludeFlags()), excludeFlags(path.m_filter.getExcludeFlags()),
+    pointPathLimit(path.m_pointPathLimit), options(0)
+{
+    start[0] = path.m_startPosition.x;
+    start[1] = path.m_startPosition.y;
+    start[2] = path.m_startPosition.z;
+    end[0] = path.m_endPosition.x;
+    end[1] = path.m_endPosition.y;
+    end[2] = path.m_endPosition.z;
+
+    if (path.m_forceDestination)
+        options |= PATH_REQUEST_FORCE_DEST;
+    if (path.m_useStraightPath)
+        options |= PATH_REQUEST_STRAIGHT_PATH;
+    if (path.m_isCreature)
+        options |= PATH_REQUEST_CREATURE;
+    if (path.m_canSwim)
+        options |= PATH_REQUEST_CAN_SWIM;
+    if (path.m_canFly)
+        options |= PATH_REQUEST_CAN_FLY;
+    if (path.m_startUnderWater)
+        options |= PATH_REQUEST_START_UNDERWATER;
+    if (path.m_endUnderWater)
+        options |= PATH_REQUEST_END_UNDERWATER;
+}
+
+bool PathRequestKey::operator==(PathRequestKey const& other) const
+{
+    return mapId == other.mapId &&
+           start[0] == other.start[0] && start[1] == other.start[1] && start[2] == other.start[2] &&
+           end[0] == other.end[0] && end[1] == other.end[1] && end[2] == other.end[2] &&
+           includeFlags == other.includeFlags && excludeFlags == other.excludeFlags &&
+           pointPathLimit == other.pointPathLimit && options == other.options;
+}
+
+size_t PathRequestKeyHash::operator()(PathRequestKey const& key) const
+{
+    std::hash<float> floatHash;
+
+    size_t h = key.mapId;
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        h = h * 31 + floatHash(key.start[i]);
+        h = h * 31 + floatHash(key.end[i]);
+    }
+
+    return h * 31 + (key.includeFlags | (key.excludeFlags << 16)) + (key.options << 24);
+}
+
+PathRequest::PathRequest(PathFinder const& path, PathRequestKey const& key) :
+    m_path(path), m_key(key), m_submitTime(std::chrono::steady_clock::now()), m_done(false)
+{
+}
+
+PathFinderService::PathFinderService() : m_stopping(false),
+    m_maxQueueDepth(0), m_submitted(0), m_deduplicated(0), m_abandoned(0), m_completed(0), m_latenciesPos(0)
+{
+    m_latencies.reserve(PATHFINDER_LATENCY_WINDOW);
+}
+
+PathFinderService::~PathFinderService()
+{
+    Stop();
+}
+
+void PathFinderService::Start(uint32 threads)
+{
+    if (IsActive())
+        return;
+
+    m_stopping = false;
+
+    for (uint32 i = 0; i < threads; ++i)
+        m_workers.push_back(std::thread(&PathFinderService::WorkerThread, this));
+
+    if (threads)
+        sLog.outString("PathFinderService: searching paths on %u threads", threads);
+}
+
+void PathFinderService::Stop()
+{
+    if (!IsActive())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (std::vector<std::thread>::iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+        itr->join();
+
+    m_workers.clear();
+
+    // requests never searched stay pending, their generators go away with the maps
+    m_queue.clear();
+    m_pending.clear();
+}
+
+PathRequestPtr PathFinderService::Submit(PathFinder& path, float destX, float destY, float destZ, bool forceDest)
+{
+    if (!path.prepareCalculation(destX, destY, destZ, forceDest))
+        return PathRequestPtr();
+
+    PathRequestKey key(path);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    ++m_submitted;
+
+    PendingMap::const_iterator itr = m_pending.find(key);
+    if (itr != m_pending.end())
+    {
+        ++m_deduplicated;
+        return itr->second;
+    }
+
+    PathRequestPtr request(new PathRequest(path, key));
+    m_pending.insert(PendingMap::value_type(key, request));
+    m_queue.push_back(request);
+
+    if (m_queue.size() > m_maxQueueDepth)
+        m_maxQueueDepth = m_queue.size();
+
+    m_condition.notify_one();
+    return request;
+}
+
+void PathFinderService::WorkerThread()
+{
+    WorkerQueryMap queries;
+
+    while (true)
+    {
+        PathRequestPtr request;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+
+            while (m_queue.empty() && !m_stopping)
+                m_condition.wait(lock);
+
+            if (m_stopping)
+                break;
+
+            request = m_queue.front();
+            m_queue.pop_front();
+
+            // only the pending map and this worker hold it, the submitters moved on
+            if (request.use_count() <= 2)
+            {
+                m_pending.erase(request->m_key);
+                ++m_abandoned;
+                continue;
+            }
+        }
+
+        Compute(*request, queries);
+
+        uint32 latency = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - request->m_submitTime).count());
+
+        request->m_done.store(true, std::memory_order_release);
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_pending.erase(request->m_key);
+        ++m_completed;
+        RecordLatency(latency);
+    }
+
+    for (WorkerQueryMap::const_iterator itr = queries.begin(); itr != queries.end(); ++itr)
+        dtFreeNavMeshQuery(itr->second.query);
+}
+
+void PathFinderService::Compute(PathRequest& request, WorkerQueryMap& queries)
+{
+    uint32 mapId = request.m_path.m_mapId;
+
+    MMAP::NavMeshReadGuard guard(MMAP::MMapFactory::createOrGetMMapManager(), mapId);
+    dtNavMesh const* navMesh = guard.GetNavMesh();
+    if (!navMesh)
+    {
+        request.m_path.computePath(nullptr, nullptr);
+        return;
+    }
+
+    WorkerQueryMap::iterator itr = queries.find(mapId);
+    if (itr == queries.end())
+    {
+        WorkerQuery workerQuery;
+        workerQuery.query = dtAllocNavMeshQuery();
+        workerQuery.generation = 0;
+        MANGOS_ASSERT(workerQuery.query);
+        itr = queries.insert(WorkerQueryMap::value_type(mapId, workerQuery)).first;
+    }
+
+    // the map's nav mesh was reloaded since this worker last searched it
+    WorkerQuery& workerQuery = itr->second;
+    if (workerQuery.generation != guard.GetGeneration())
+    {
+        if (dtStatusFailed(workerQuery.query->init(navMesh, 1024)))
+        {
+            sLog.outError("PathFinderService: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+            workerQuery.generation = 0;
+            request.m_path.computePath(nullptr, nullptr);
+            return;
+        }
+
+        workerQuery.generation = guard.GetGeneration();
+    }
+
+    request.m_path.computePath(navMesh, workerQuery.query);
+}
+
+void PathFinderService::RecordLatency(uint32 latency)
+{
+    if (m_latencies.size() < PATHFINDER_LATENCY_WINDOW)
+    {
+        m_latencies.push_back(latency);
+        return;
+    }
+
+    m_latencies[m_latenciesPos] = latency;
+    m_latenciesPos = (m_latenciesPos + 1) % PATHFINDER_LATENCY_WINDOW;
+}
+
+void PathFinderService::GetStats(PathFinderServiceStats& stats) const
+{
+    std::vector<uint32> latencies;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        stats.threads = m_workers.size();
+        stats.queueDepth = m_queue.size();
+        stats.maxQueueDepth = m_maxQueueDepth;
+        stats.submitted = m_submitted;
+        stats.deduplicated = m_deduplicated;
+        stats.abandoned = m_abandoned;
+        stats.completed = m_completed;
+        latencies = m_latencies;
+    }
+
+    stats.latencySamples = latencies.size();
+    stats.latencyP50 = 0;
+    stats.latencyP99 = 0;
+
+    if (latencies.empty())
+        return;
+
+    std::vector<uint32>::iterator p50 = latencies.begin() + latencies.size() / 2;
+    std::nth_element(latencies.begin(), p50, latencies.end());
+    stats.latencyP50 = *p50;
+
+    std::vector<uint32>::iterator p99 = latencies.begin() + latencies.size() * 99 / 100;
+    std::nth_element(latencies.begin(), p99, latencies.end());
+    stats.latencyP99 = *p99;
+}
+
+void PathFinderService::ResetStats()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_maxQueueDepth = m_queue.size();
+    m_submitted = 0;
+    m_deduplicated = 0;
+    m_abandoned = 0;
+    m_completed = 0;
+    m_latencies.clear();
+    m_latenciesPos = 0;
+}
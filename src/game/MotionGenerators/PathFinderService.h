@@ -0,0 +1,153 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PATHFINDERSERVICE_H
+#define MANGOS_PATHFINDERSERVICE_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "MotionGenerators/PathFinder.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define PATHFINDER_LATENCY_WINDOW 1024                      // completed requests in the latency percentiles
+
+/// Everything the search result depends on, except the old corridor of the submitter
+struct PathRequestKey
+{
+    explicit PathRequestKey(PathFinder const& path);
+
+    bool operator==(PathRequestKey const& other) const;
+
+    uint32 mapId;
+    float start[3];
+    float end[3];
+    uint16 includeFlags;
+    uint16 excludeFlags;
+    uint32 pointPathLimit;
+    uint32 options;                                         // PathRequestOptions
+};
+
+struct PathRequestKeyHash
+{
+    size_t operator()(PathRequestKey const& key) const;
+};
+
+class PathRequest
+{
+    public:
+        PathRequest(PathFinder const& path, PathRequestKey const& key);
+
+        bool IsDone() const { return m_done.load(std::memory_order_acquire); }
+
+        /// Only valid once IsDone
+        PathFinder const& GetPath() const { return m_path; }
+
+    private:
+        friend class PathFinderService;
+
+        PathFinder m_path;                                  // copy of the submitter's path finder, built by a worker
+        PathRequestKey m_key;
+        std::chrono::steady_clock::time_point m_submitTime;
+        std::atomic<bool> m_done;
+};
+
+typedef std::shared_ptr<PathRequest> PathRequestPtr;
+
+struct PathFinderServiceStats
+{
+    uint32 threads;
+    uint32 queueDepth;
+    uint32 maxQueueDepth;
+    uint64 submitted;
+    uint64 deduplicated;                                    // joined an identical pending request
+    uint64 abandoned;                                       // dropped before the search, nobody waited anymore
+    uint64 completed;
+    uint32 latencySamples;
+    uint32 latencyP50;                                      // microseconds from submit to result
+    uint32 latencyP99;
+};
+
+/**
+ * Searches navmesh paths outside of the map update.
+ *
+ * Movement generators prepare their PathFinder on the map thread (positions, filter, liquid state),
+ * submit it and take the result over on a later update with PathFinder::finishCalculation.
+ * Every worker owns one dtNavMeshQuery per map, the nav mesh is held by MMAP::NavMeshReadGuard
+ * during the search. Requests equal in all search inputs while one of them is pending share it.
+ */
+class PathFinderService
+{
+    public:
+        PathFinderService();
+        ~PathFinderService();
+
+        void Start(uint32 threads);
+        void Stop();
+
+        bool IsActive() const { return !m_workers.empty(); }
+
+        /// Returns an empty pointer if the path did not need a navmesh search and is done already
+        PathRequestPtr Submit(PathFinder& path, float destX, float destY, float destZ, bool forceDest);
+
+        void GetStats(PathFinderServiceStats& stats) const;
+        void ResetStats();
+
+    private:
+        struct WorkerQuery
+        {
+            dtNavMeshQuery* query;
+            uint32 generation;                              // of the nav mesh the query was initialized with
+        };
+
+        typedef std::unordered_map<uint32, WorkerQuery> WorkerQueryMap;
+        typedef std::unordered_map<PathRequestKey, PathRequestPtr, PathRequestKeyHash> PendingMap;
+
+        void WorkerThread();
+        void Compute(PathRequest& request, WorkerQueryMap& queries);
+        void RecordLatency(uint32 latency);
+
+        std::vector<std::thread> m_workers;
+
+        mutable std::mutex m_lock;
+        std::condition_variable m_condition;
+        std::deque<PathRequestPtr> m_queue;
+        PendingMap m_pending;                               // queued or in search, by search inputs
+        bool m_stopping;
+
+        // stats, guarded by m_lock
+        uint32 m_maxQueueDepth;
+        uint64 m_submitted;
+        uint64 m_deduplicated;
+        uint64 m_abandoned;
+        uint64 m_completed;
+        std::vector<uint32> m_latencies;
+        uint32 m_latenciesPos;
+};
+
+#define sPathFinderService MaNGOS::Singleton<PathFinderService>::Instance()
+
+#endif
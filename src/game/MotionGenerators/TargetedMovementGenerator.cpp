@@ -18,6 +18,7 @@
 
 #include "MotionGenerators/TargetedMovementGenerator.h"
 #include "MotionGenerators/PathFinder.h"
+#include "MotionGenerators/PathFinderService.h"
 #include "Entities/Unit.h"
 #include "Entities/Creature.h"
 #include "Entities/Player.h"
@@ -75,7 +76,23 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T& owner, bool up
     // allow pets following their master to cheat while generating paths
     bool forceDest = (owner.GetTypeId() == TYPEID_UNIT && ((Creature*)&owner)->IsPet()
                       && owner.hasUnitState(UNIT_STAT_FOLLOW));
-    i_path->calculate(x, y, z, forceDest);
+
+    if (sPathFinderService.IsActive())
+    {
+        // the search runs on a pathfinding worker, Update launches the movement once it is done
+        i_pathRequest = sPathFinderService.Submit(*i_path, x, y, z, forceDest);
+        if (i_pathRequest)
+            return;
+    }
+    else
+        i_path->calculate(x, y, z, forceDest);
+
+    _moveByPath(owner);
+}
+
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T, D>::_moveByPath(T& owner)
+{
     if (i_path->getPathType() & PATHFIND_NOPATH)
         return;
 
@@ -134,10 +151,18 @@ bool TargetedMovementGeneratorMedium<T, D>::Update(T& owner, const uint32& time_
         targetMoved = RequiresNewPosition(owner, dest.x, dest.y, dest.z);
     }
 
-    if (m_speedChanged || targetMoved)
+    if (i_pathRequest && i_pathRequest->IsDone())
+    {
+        i_path->finishCalculation(i_pathRequest->GetPath());
+        i_pathRequest.reset();
+        _moveByPath(owner);
+    }
+
+    // a pending search is not replaced, the next recheck after its result sees if the target moved on
+    if ((m_speedChanged || targetMoved) && !i_pathRequest)
         _setTargetLocation(owner, targetMoved);
 
-    if (owner.movespline->Finalized())
+    if (owner.movespline->Finalized() && !i_pathRequest)
     {
         if (i_angle == 0.f && !owner.HasInArc(0.01f, i_target.getTarget()))
             owner.SetInFront(i_target.getTarget());
@@ -154,7 +179,8 @@ bool TargetedMovementGeneratorMedium<T, D>::Update(T& owner, const uint32& time_
 template<class T, typename D>
 bool TargetedMovementGeneratorMedium<T, D>::IsReachable() const
 {
-    return (i_path) ? (i_path->getPathType() & PATHFIND_NORMAL) : true;
+    // no path searched yet, the first search may still be pending
+    return (i_path && i_path->getPathType() != PATHFIND_BLANK) ? (i_path->getPathType() & PATHFIND_NORMAL) : true;
 }
 
 template<class T, typename D>
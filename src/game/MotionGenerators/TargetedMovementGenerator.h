@@ -22,7 +22,10 @@
 #include "MotionGenerators/MovementGenerator.h"
 #include "MotionGenerators/FollowerReference.h"
 
+#include <memory>
+
 class PathFinder;
+class PathRequest;
 
 class TargetedMovementGeneratorBase
 {
@@ -59,6 +62,7 @@ class TargetedMovementGeneratorMedium
 
     protected:
         void _setTargetLocation(T&, bool updateDestination);
+        void _moveByPath(T&);
         bool RequiresNewPosition(T& owner, float x, float y, float z) const;
         virtual float GetDynamicTargetDistance(T& /*owner*/, bool /*forRangeCheck*/) const { return i_offset; }
 
@@ -69,6 +73,7 @@ class TargetedMovementGeneratorMedium
         bool i_targetReached : 1;
 
         PathFinder* i_path;
+        std::shared_ptr<PathRequest> i_pathRequest;         // path searched by sPathFinderService, moved along once done
 };
 
 template<class T>
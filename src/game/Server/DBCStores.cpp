@@ -22,6 +22,7 @@
 #include "ProgressBar.h"
 #include "Globals/SharedDefines.h"
 #include "Server/SQLStorages.h"
+#include "Timer.h"
 
 #include "DBCfmt.h"
 
@@ -164,6 +165,12 @@ DBCStorage <WorldSafeLocsEntry> sWorldSafeLocsStore(WorldSafeLocsEntryfmt);
 
 typedef std::list<std::string> StoreProblemList;
 
+// optional image of the loaded stores, see DBCSnapshot
+static DBCSnapshot sDBCSnapshot;
+static bool sDBCSnapshotEnabled = false;
+static bool sDBCSnapshotStale = false;                      // a store was loaded from its .dbc files
+static uint32 sDBCSnapshotLoaded = 0;
+
 bool IsAcceptableClientBuild(uint32 build)
 {
     int accepted_versions[] = EXPECTED_MANGOSD_CLIENT_BUILD;
@@ -191,12 +198,44 @@ static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string&
     return false;
 }
 
+// name, size and modification time of the default and locale files of a store
+static uint64 GetDBCSourceSignature(uint32& availableDbcLocales, const std::string& dbc_path, const std::string& filename)
+{
+    uint64 signature = 0;
+    DBCSnapshot::AddSourceFile(signature, (dbc_path + filename).c_str());
+
+    for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
+    {
+        if (!(availableDbcLocales & (1 << i)))
+            continue;
+
+        std::string dbc_filename_loc = dbc_path + fullLocaleNameList[i].name + "/" + filename;
+        if (!DBCSnapshot::AddSourceFile(signature, dbc_filename_loc.c_str()))
+            availableDbcLocales &= ~(1 << i);               // mark as not available for speedup next checks
+    }
+
+    return signature;
+}
+
 template<class T>
 inline void LoadDBC(uint32& availableDbcLocales, BarGoLink& bar, StoreProblemList& errlist, DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename)
 {
     // compatibility format and C++ structure sizes
     MANGOS_ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
 
+    uint64 signature = 0;
+    if (sDBCSnapshotEnabled)
+    {
+        signature = GetDBCSourceSignature(availableDbcLocales, dbc_path, filename);
+        if (storage.LoadFromSnapshot(sDBCSnapshot, filename.c_str(), signature))
+        {
+            storage.AddToSnapshot(sDBCSnapshot, filename.c_str(), signature);
+            ++sDBCSnapshotLoaded;
+            bar.step();
+            return;
+        }
+    }
+
     std::string dbc_filename = dbc_path + filename;
     if (storage.Load(dbc_filename.c_str()))
     {
@@ -210,6 +249,12 @@ inline void LoadDBC(uint32& availableDbcLocales, BarGoLink& bar, StoreProblemLis
             if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
                 availableDbcLocales &= ~(1 << i);           // mark as not available for speedup next checks
         }
+
+        if (sDBCSnapshotEnabled)
+        {
+            storage.AddToSnapshot(sDBCSnapshot, filename.c_str(), signature);
+            sDBCSnapshotStale = true;
+        }
     }
     else
     {
@@ -227,9 +272,16 @@ inline void LoadDBC(uint32& availableDbcLocales, BarGoLink& bar, StoreProblemLis
     }
 }
 
-void LoadDBCStores(const std::string& dataPath)
+void LoadDBCStores(const std::string& dataPath, bool useSnapshot)
 {
     std::string dbcPath = dataPath + "dbc/";
+    std::string snapshotFile = dbcPath + "dbc.snapshot";
+
+    uint32 startTime = WorldTimer::getMSTime();
+
+    sDBCSnapshotEnabled = useSnapshot;
+    if (useSnapshot && !sDBCSnapshot.Open(snapshotFile.c_str()))
+        sLog.outString("DBC snapshot %s not found or not valid for this build, loading *.dbc files", snapshotFile.c_str());
 
     const uint32 DBCFilesCount = 66;
 
@@ -550,7 +602,19 @@ void LoadDBCStores(const std::string& dataPath)
         exit(1);
     }
 
-    sLog.outString(">> Initialized %d data stores", DBCFilesCount);
+    if (sDBCSnapshotStale)
+    {
+        if (sDBCSnapshot.Write(snapshotFile.c_str()))
+            sLog.outString("Wrote DBC snapshot %s", snapshotFile.c_str());
+        else
+            sLog.outError("Could not write DBC snapshot %s", snapshotFile.c_str());
+    }
+    sDBCSnapshot.ClearStores();
+
+    if (useSnapshot)
+        sLog.outString(">> Initialized %d data stores in %u ms, %u from snapshot", DBCFilesCount, WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()), sDBCSnapshotLoaded);
+    else
+        sLog.outString(">> Initialized %d data stores in %u ms", DBCFilesCount, WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
     sLog.outString();
 }
 
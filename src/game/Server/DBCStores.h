@@ -147,7 +147,7 @@ extern DBCStorage <WMOAreaTableEntry>            sWMOAreaTableStore;
 // extern DBCStorage <WorldMapOverlayEntry>         sWorldMapOverlayStore; -- not used currently
 extern DBCStorage <WorldSafeLocsEntry>           sWorldSafeLocsStore;
 
-void LoadDBCStores(const std::string& dataPath);
+void LoadDBCStores(const std::string& dataPath, bool useSnapshot);
 
 // script support functions
 DBCStorage <SoundEntriesEntry>          const* GetSoundEntriesStore();
@@ -0,0 +1,338 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Social/PlayerDirectory.h"
+#include "Entities/Player.h"
+#include "Guilds/GuildMgr.h"
+#include "Server/DBCStores.h"
+#include "Server/WorldSession.h"
+#include "Util.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(PlayerDirectory);
+
+static uint32 GetLevelIndex(uint32 level)
+{
+    return level < STRONG_MAX_LEVEL ? level : STRONG_MAX_LEVEL;
+}
+
+PlayerDirectory::PlayerDirectory()
+{
+}
+
+void PlayerDirectory::AddPlayer(Player* player)
+{
+    std::wstring wname;
+    if (!Utf8toWStr(player->GetName(), wname))
+        return;
+    wstrToLower(wname);
+
+    uint32 zoneId = player->GetZoneId();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    std::pair<EntryMap::iterator, bool> res = m_entries.insert(EntryMap::value_type(player->GetGUIDLow(), Entry()));
+    Entry& entry = res.first->second;
+    if (!res.second)
+    {
+        UnlinkLevel(entry);
+        UnlinkZone(entry);
+    }
+
+    entry.player = player;
+    entry.wname = wname;
+    entry.guildId = player->GetGuildId();
+    entry.level = player->getLevel();
+    entry.zoneId = zoneId;
+
+    LinkLevel(entry);
+    LinkZone(entry);
+    m_byName[entry.wname] = &entry;
+}
+
+void PlayerDirectory::RemovePlayer(Player* player)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    EntryMap::iterator itr = m_entries.find(player->GetGUIDLow());
+    if (itr == m_entries.end() || itr->second.player != player)
+        return;
+
+    Entry& entry = itr->second;
+    UnlinkLevel(entry);
+    UnlinkZone(entry);
+    m_byName.erase(entry.wname);
+    m_entries.erase(itr);
+}
+
+void PlayerDirectory::UpdateLevel(Player* player)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    EntryMap::iterator itr = m_entries.find(player->GetGUIDLow());
+    if (itr == m_entries.end() || itr->second.player != player)
+        return;
+
+    Entry& entry = itr->second;
+    UnlinkLevel(entry);
+    entry.level = player->getLevel();
+    LinkLevel(entry);
+}
+
+void PlayerDirectory::UpdateZone(Player* player, uint32 zoneId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    EntryMap::iterator itr = m_entries.find(player->GetGUIDLow());
+    if (itr == m_entries.end() || itr->second.player != player || itr->second.zoneId == zoneId)
+        return;
+
+    Entry& entry = itr->second;
+    UnlinkZone(entry);
+    entry.zoneId = zoneId;
+    LinkZone(entry);
+}
+
+void PlayerDirectory::UpdateGuild(Player* player)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    EntryMap::iterator itr = m_entries.find(player->GetGUIDLow());
+    if (itr != m_entries.end() && itr->second.player == player)
+        itr->second.guildId = player->GetGuildId();
+}
+
+Player* PlayerDirectory::FindPlayerByName(std::string const& name) const
+{
+    std::wstring wname;
+    if (!Utf8toWStr(name, wname))
+        return nullptr;
+    wstrToLower(wname);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    NameIndex::const_iterator itr = m_byName.find(wname);
+    return itr != m_byName.end() ? itr->second->player : nullptr;
+}
+
+void PlayerDirectory::LinkLevel(Entry& entry)
+{
+    EntryList& list = m_byLevel[GetLevelIndex(entry.level)];
+    entry.levelSlot = list.size();
+    list.push_back(&entry);
+}
+
+void PlayerDirectory::UnlinkLevel(Entry& entry)
+{
+    EntryList& list = m_byLevel[GetLevelIndex(entry.level)];
+    list[entry.levelSlot] = list.back();
+    list[entry.levelSlot]->levelSlot = entry.levelSlot;
+    list.pop_back();
+}
+
+void PlayerDirectory::LinkZone(Entry& entry)
+{
+    EntryList& list = m_byZone[entry.zoneId];
+    entry.zoneSlot = list.size();
+    list.push_back(&entry);
+}
+
+void PlayerDirectory::UnlinkZone(Entry& entry)
+{
+    ZoneIndex::iterator itr = m_byZone.find(entry.zoneId);
+    EntryList& list = itr->second;
+    list[entry.zoneSlot] = list.back();
+    list[entry.zoneSlot]->zoneSlot = entry.zoneSlot;
+    list.pop_back();
+
+    if (list.empty())
+        m_byZone.erase(itr);
+}
+
+PlayerDirectory::GuildName const* PlayerDirectory::GetGuildName(uint32 guildId)
+{
+    GuildNameMap::const_iterator itr = m_guildNames.find(guildId);
+    if (itr != m_guildNames.end())
+        return &itr->second;
+
+    // a new guild adds its leader before it is registered, try again with the next query
+    std::string name = sGuildMgr.GetGuildNameById(guildId);
+    if (name.empty())
+        return nullptr;
+
+    GuildName& guildName = m_guildNames[guildId];
+    guildName.name = name;
+    if (Utf8toWStr(name, guildName.wname))
+        wstrToLower(guildName.wname);
+    return &guildName;
+}
+
+bool PlayerDirectory::IsMatching(Entry const& entry, WhoListQuery const& query, GuildName const* guild, std::unordered_map<uint32, bool>& zoneNameMatches) const
+{
+    if (entry.level < query.levelMin || entry.level > query.levelMax)
+        return false;
+
+    Player* player = entry.player;
+
+    if (!(query.classMask & (1 << player->getClass())))
+        return false;
+
+    if (!(query.raceMask & (1 << player->getRace())))
+        return false;
+
+    if (query.zonesCount)
+    {
+        uint32 i = 0;
+        while (i < query.zonesCount && query.zoneIds[i] != entry.zoneId)
+            ++i;
+        if (i == query.zonesCount)
+            return false;
+    }
+
+    if (query.checkSecurity)
+    {
+        // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
+        if (player->GetTeam() != query.searcher->GetTeam() && !query.allowTwoSide)
+            return false;
+
+        // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+        if (uint32(player->GetSession()->GetSecurity()) > query.gmLevelInList)
+            return false;
+    }
+
+    // do not process players which are not in world
+    if (!player->IsInWorld())
+        return false;
+
+    // check if target is globally visible for player
+    if (!player->IsVisibleGloballyFor(query.searcher))
+        return false;
+
+    if (!query.playerName.empty() && entry.wname.find(query.playerName) == std::wstring::npos)
+        return false;
+
+    std::wstring const emptyName;
+    std::wstring const& wgname = guild ? guild->wname : emptyName;
+
+    if (!query.guildName.empty() && wgname.find(query.guildName) == std::wstring::npos)
+        return false;
+
+    bool s_show = true;
+    for (uint32 i = 0; i < query.stringsCount; ++i)
+    {
+        std::wstring const& str = query.strings[i];
+        if (str.empty())
+            continue;
+
+        if (wgname.find(str) != std::wstring::npos || entry.wname.find(str) != std::wstring::npos)
+            return true;
+
+        // zone names are converted once per query and zone
+        uint32 key = (entry.zoneId << 2) | i;
+        std::unordered_map<uint32, bool>::const_iterator itr = zoneNameMatches.find(key);
+        if (itr == zoneNameMatches.end())
+        {
+            bool fit = false;
+            if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(entry.zoneId))
+                fit = Utf8FitTo(areaEntry->area_name[query.locale], str);
+            itr = zoneNameMatches.insert(std::make_pair(key, fit)).first;
+        }
+
+        if (itr->second)
+            return true;
+
+        s_show = false;
+    }
+
+    return s_show;
+}
+
+uint32 PlayerDirectory::SearchWhoList(WhoListQuery const& query, uint32 maxMatches, std::vector<WhoListMatch>& matches)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    uint32 levelMin = GetLevelIndex(query.levelMin);
+    uint32 levelMax = GetLevelIndex(query.levelMax);
+
+    size_t levelCandidates = 0;
+    for (uint32 level = levelMin; level <= levelMax; ++level)
+        levelCandidates += m_byLevel[level].size();
+
+    // walk the asked zones instead of the level range if they hold less players
+    std::vector<EntryList const*> lists;
+    if (query.zonesCount)
+    {
+        size_t zoneCandidates = 0;
+        for (uint32 i = 0; i < query.zonesCount; ++i)
+        {
+            ZoneIndex::const_iterator itr = m_byZone.find(query.zoneIds[i]);
+            if (itr == m_byZone.end())
+                continue;
+
+            // client may send a zone twice
+            if (std::find(lists.begin(), lists.end(), &itr->second) != lists.end())
+                continue;
+
+            lists.push_back(&itr->second);
+            zoneCandidates += itr->second.size();
+        }
+
+        if (zoneCandidates > levelCandidates)
+            lists.clear();
+        else if (lists.empty())
+            return 0;
+    }
+
+    if (lists.empty())
+        for (uint32 level = levelMin; level <= levelMax; ++level)
+            if (!m_byLevel[level].empty())
+                lists.push_back(&m_byLevel[level]);
+
+    std::unordered_map<uint32, bool> zoneNameMatches;
+    uint32 matchCount = 0;
+
+    for (std::vector<EntryList const*>::const_iterator lItr = lists.begin(); lItr != lists.end(); ++lItr)
+    {
+        for (EntryList::const_iterator itr = (*lItr)->begin(); itr != (*lItr)->end(); ++itr)
+        {
+            Entry const& entry = **itr;
+
+            GuildName const* guild = entry.guildId ? GetGuildName(entry.guildId) : nullptr;
+            if (!IsMatching(entry, query, guild, zoneNameMatches))
+                continue;
+
+            if (++matchCount > maxMatches)
+                continue;
+
+            Player* player = entry.player;
+
+            WhoListMatch match;
+            match.name = player->GetName();
+            match.guildName = guild ? guild->name : "";
+            match.level = entry.level;
+            match.class_ = player->getClass();
+            match.race = player->getRace();
+            match.gender = player->getGender();
+            match.zoneId = entry.zoneId;
+            matches.push_back(match);
+        }
+    }
+
+    return matchCount;
+}
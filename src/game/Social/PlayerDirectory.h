@@ -0,0 +1,138 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PLAYERDIRECTORY_H
+#define MANGOS_PLAYERDIRECTORY_H
+
+#include "Common.h"
+#include "Server/DBCEnums.h"
+#include "Policies/Singleton.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Player;
+
+#define WHO_LIST_MAX_ZONES   10                             // client limit
+#define WHO_LIST_MAX_STRINGS 4                              // client limit
+
+/// CMSG_WHO search criteria, all strings lowercase
+struct WhoListQuery
+{
+    WhoListQuery() : searcher(nullptr), levelMin(0), levelMax(STRONG_MAX_LEVEL), raceMask(0), classMask(0),
+        zonesCount(0), stringsCount(0), locale(LOCALE_enUS), allowTwoSide(false), checkSecurity(false), gmLevelInList(0) {}
+
+    Player* searcher;
+    uint32 levelMin;
+    uint32 levelMax;
+    uint32 raceMask;
+    uint32 classMask;
+    uint32 zoneIds[WHO_LIST_MAX_ZONES];
+    uint32 zonesCount;
+    std::wstring playerName;
+    std::wstring guildName;
+    std::wstring strings[WHO_LIST_MAX_STRINGS];
+    uint32 stringsCount;
+    LocaleConstant locale;                                  // for the zone names matched by strings
+    bool allowTwoSide;
+    bool checkSecurity;                                     // apply team and gm level restrictions of player accounts
+    uint32 gmLevelInList;
+};
+
+struct WhoListMatch
+{
+    std::string name;
+    std::string guildName;
+    uint32 level;
+    uint32 class_;
+    uint32 race;
+    uint8 gender;
+    uint32 zoneId;
+};
+
+/**
+ * Directory of the online players for /who and name lookups.
+ *
+ * Kept up to date on login, logout, level, zone and guild changes. Every entry holds the
+ * lowercased wide name ready for matching, and players are indexed by level and by zone,
+ * so a who query only walks the players of the asked level range or zones, whichever is smaller.
+ */
+class PlayerDirectory
+{
+    public:
+        PlayerDirectory();
+
+        void AddPlayer(Player* player);
+        void RemovePlayer(Player* player);
+        void UpdateLevel(Player* player);
+        void UpdateZone(Player* player, uint32 zoneId);
+        void UpdateGuild(Player* player);
+
+        /// Exact, case insensitive name lookup
+        Player* FindPlayerByName(std::string const& name) const;
+
+        /// Returns the number of matching players, fills at most maxMatches of them
+        uint32 SearchWhoList(WhoListQuery const& query, uint32 maxMatches, std::vector<WhoListMatch>& matches);
+
+    private:
+        struct Entry
+        {
+            Player* player;
+            std::wstring wname;                             // lowercase
+            uint32 guildId;
+            uint32 level;
+            uint32 zoneId;
+            size_t levelSlot;                               // position in m_byLevel[level]
+            size_t zoneSlot;                                // position in m_byZone[zoneId]
+        };
+
+        struct GuildName
+        {
+            std::string name;
+            std::wstring wname;                             // lowercase
+        };
+
+        typedef std::vector<Entry*> EntryList;
+        typedef std::unordered_map<uint32, Entry> EntryMap;
+        typedef std::unordered_map<uint32, EntryList> ZoneIndex;
+        typedef std::unordered_map<std::wstring, Entry*> NameIndex;
+        typedef std::unordered_map<uint32, GuildName> GuildNameMap;
+
+        void LinkLevel(Entry& entry);
+        void UnlinkLevel(Entry& entry);
+        void LinkZone(Entry& entry);
+        void UnlinkZone(Entry& entry);
+
+        GuildName const* GetGuildName(uint32 guildId);
+        bool IsMatching(Entry const& entry, WhoListQuery const& query, GuildName const* guild, std::unordered_map<uint32, bool>& zoneNameMatches) const;
+
+        EntryMap m_entries;                                 // by guid low
+        EntryList m_byLevel[STRONG_MAX_LEVEL + 1];
+        ZoneIndex m_byZone;
+        NameIndex m_byName;
+        GuildNameMap m_guildNames;                          // filled on first query, guild names never change
+
+        // level and zone changes arrive from the map update threads
+        mutable std::mutex m_lock;
+};
+
+#define sPlayerDirectory MaNGOS::Singleton<PlayerDirectory>::Instance()
+
+#endif
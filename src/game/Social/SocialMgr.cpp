@@ -79,6 +79,9 @@ bool PlayerSocial::AddToSocialList(ObjectGuid friend_guid, bool ignore)
         fi.Flags |= flag;
         m_playerSocialMap[friend_guid.GetCounter()] = fi;
     }
+
+    if (ignore)
+        sSocialMgr.AddIgnore(m_playerLowGuid, friend_guid.GetCounter());
     return true;
 }
 
@@ -90,7 +93,10 @@ void PlayerSocial::RemoveFromSocialList(ObjectGuid friend_guid, bool ignore)
 
     uint32 flag = SOCIAL_FLAG_FRIEND;
     if (ignore)
+    {
         flag = SOCIAL_FLAG_IGNORED;
+        sSocialMgr.RemoveIgnore(m_playerLowGuid, friend_guid.GetCounter());
+    }
 
     itr->second.Flags &= ~flag;
     if (itr->second.Flags == 0)
@@ -296,6 +302,48 @@ void SocialMgr::BroadcastToFriendListers(Player* player, WorldPacket const& pack
     }
 }
 
+void SocialMgr::RemovePlayerSocial(uint32 guid)
+{
+    SocialMap::iterator itr = m_socialMap.find(guid);
+    if (itr == m_socialMap.end())
+        return;
+
+    PlayerSocialMap const& socials = itr->second.m_playerSocialMap;
+    for (PlayerSocialMap::const_iterator sItr = socials.begin(); sItr != socials.end(); ++sItr)
+        if (sItr->second.Flags & SOCIAL_FLAG_IGNORED)
+            RemoveIgnore(guid, sItr->first);
+
+    m_socialMap.erase(itr);
+}
+
+void SocialMgr::AddIgnore(uint32 ignorerGuid, uint32 ignoredGuid)
+{
+    std::lock_guard<std::mutex> guard(m_ignoredByLock);
+    m_ignoredBy[ignoredGuid].insert(ignorerGuid);
+}
+
+void SocialMgr::RemoveIgnore(uint32 ignorerGuid, uint32 ignoredGuid)
+{
+    std::lock_guard<std::mutex> guard(m_ignoredByLock);
+
+    IgnoredByMap::iterator itr = m_ignoredBy.find(ignoredGuid);
+    if (itr == m_ignoredBy.end())
+        return;
+
+    itr->second.erase(ignorerGuid);
+    if (itr->second.empty())
+        m_ignoredBy.erase(itr);
+}
+
+void SocialMgr::GetIgnoringPlayers(uint32 ignoredGuid, std::vector<uint32>& ignoring) const
+{
+    std::lock_guard<std::mutex> guard(m_ignoredByLock);
+
+    IgnoredByMap::const_iterator itr = m_ignoredBy.find(ignoredGuid);
+    if (itr != m_ignoredBy.end())
+        ignoring.assign(itr->second.begin(), itr->second.end());
+}
+
 PlayerSocial* SocialMgr::LoadFromDB(QueryResult* result, ObjectGuid guid)
 {
     PlayerSocial* social = &m_socialMap[guid.GetCounter()];
@@ -323,7 +371,10 @@ PlayerSocial* SocialMgr::LoadFromDB(QueryResult* result, ObjectGuid guid)
         social->m_playerSocialMap[friend_guid] = FriendInfo(flags, note);
 
         if (flags & SOCIAL_FLAG_IGNORED)
+        {
+            AddIgnore(guid.GetCounter(), friend_guid);
             ++ignoreCounter;
+        }
         else
             ++friendCounter;
     }
@@ -22,6 +22,11 @@
 #include "Database/DatabaseEnv.h"
 #include "Entities/ObjectGuid.h"
 
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
 class SocialMgr;
 class PlayerSocial;
 class Player;
@@ -136,7 +141,13 @@ class SocialMgr
         SocialMgr();
         ~SocialMgr();
         // Misc
-        void RemovePlayerSocial(uint32 guid) { m_socialMap.erase(guid); }
+        void RemovePlayerSocial(uint32 guid);
+
+        // reverse ignore index of the loaded socials
+        void AddIgnore(uint32 ignorerGuid, uint32 ignoredGuid);
+        void RemoveIgnore(uint32 ignorerGuid, uint32 ignoredGuid);
+        /// Sorted low guids of the online players that ignore the player
+        void GetIgnoringPlayers(uint32 ignoredGuid, std::vector<uint32>& ignoring) const;
 
         void GetFriendInfo(Player* player, uint32 friendGUID, FriendInfo& friendInfo) const;
         // Packet management
@@ -147,6 +158,10 @@ class SocialMgr
         PlayerSocial* LoadFromDB(QueryResult* result, ObjectGuid guid);
     private:
         SocialMap m_socialMap;
+
+        typedef std::unordered_map<uint32, std::set<uint32> > IgnoredByMap;
+        IgnoredByMap m_ignoredBy;                           // ignored player -> online players ignoring him
+        mutable std::mutex m_ignoredByLock;
 };
 
 #define sSocialMgr MaNGOS::Singleton<SocialMgr>::Instance()
@@ -641,6 +641,9 @@ void Spell::FillTargetMap()
             }
         }
 
+        // area targets grow the list at once instead of by doubling
+        m_UniqueTargetInfo.reserve(m_UniqueTargetInfo.size() + tmpUnitLists[effToIndex[i]].size());
+
         for (UnitList::const_iterator iunit = tmpUnitLists[effToIndex[i]].begin(); iunit != tmpUnitLists[effToIndex[i]].end(); ++iunit)
             AddUnitTarget((*iunit), SpellEffectIndex(i));
     }
@@ -957,7 +960,10 @@ void Spell::DoAllEffectOnTarget(TargetInfo* target)
     // FIXME: in case wild GO heal/damage spells will be used target bonuses
     Unit* caster = real_caster ? real_caster : m_caster;
 
+    // read now, effects may add targets and move the target list
     SpellMissInfo missInfo = target->missCondition;
+    SpellMissInfo reflectResult = target->reflectResult;
+    uint32 hitInfo = target->HitInfo;
     // Need init unitTarget by default unit (can changed in code on reflect)
     // Or on missInfo!=SPELL_MISS_NONE unitTarget undefined (but need in trigger subsystem)
     unitTarget = unit;
@@ -998,7 +1004,7 @@ void Spell::DoAllEffectOnTarget(TargetInfo* target)
     {
         if (missInfo == SPELL_MISS_REFLECT)                // In case spell reflect from target, do all effect on caster (if hit)
         {
-            if (target->reflectResult == SPELL_MISS_NONE)       // If reflected spell hit caster -> do all effect on him
+            if (reflectResult == SPELL_MISS_NONE)           // If reflected spell hit caster -> do all effect on him
             {
                 DoSpellHitOnUnit(m_caster, mask, true);
                 unitTarget = m_caster;
@@ -1060,7 +1066,7 @@ void Spell::DoAllEffectOnTarget(TargetInfo* target)
         if (speed > 0.0f)
         {
             damageInfo.damage = m_damage;
-            damageInfo.HitInfo = target->HitInfo;
+            damageInfo.HitInfo = hitInfo;
         }
         // Add bonuses and fill damageInfo struct
         else
@@ -1360,17 +1366,21 @@ void Spell::DoAllEffectOnTarget(GOTargetInfo* target)
 
 void Spell::DoAllEffectOnTarget(ItemTargetInfo* target)
 {
+    Item* item = target->item;
     uint32 effectMask = target->effectMask;
-    if (!target->item || !effectMask)
+    if (!item || !effectMask)
         return;
 
     for (int effectNumber = 0; effectNumber < MAX_EFFECT_INDEX; ++effectNumber)
         if (effectMask & (1 << effectNumber))
-            HandleEffects(nullptr, target->item, nullptr, SpellEffectIndex(effectNumber));
+            HandleEffects(nullptr, item, nullptr, SpellEffectIndex(effectNumber));
 }
 
-void Spell::HandleDelayedSpellLaunch(TargetInfo* target)
+void Spell::HandleDelayedSpellLaunch(size_t targetIndex)
 {
+    // effect handlers may add targets and move the list, the entry is fetched again after them
+    TargetInfo const* target = &m_UniqueTargetInfo[targetIndex];
+
     // Get mask of effects for target
     uint32 mask = target->effectMask;
 
@@ -1384,6 +1394,7 @@ void Spell::HandleDelayedSpellLaunch(TargetInfo* target)
     Unit* caster = real_caster ? real_caster : m_caster;
 
     SpellMissInfo missInfo = target->missCondition;
+    SpellMissInfo reflectResult = target->reflectResult;
     // Need init unitTarget by default unit (can changed in code on reflect)
     // Or on missInfo!=SPELL_MISS_NONE unitTarget undefined (but need in trigger subsystem)
     unitTarget = unit;
@@ -1396,7 +1407,7 @@ void Spell::HandleDelayedSpellLaunch(TargetInfo* target)
     SpellNonMeleeDamage damageInfo(caster, unitTarget, m_spellInfo->Id, m_spellSchoolMask);
 
     // keep damage amount for reflected spells
-    if (missInfo == SPELL_MISS_NONE || (missInfo == SPELL_MISS_REFLECT && target->reflectResult == SPELL_MISS_NONE))
+    if (missInfo == SPELL_MISS_NONE || (missInfo == SPELL_MISS_REFLECT && reflectResult == SPELL_MISS_NONE))
     {
         for (int32 effectNumber = 0; effectNumber < MAX_EFFECT_INDEX; ++effectNumber)
         {
@@ -1420,8 +1431,9 @@ void Spell::HandleDelayedSpellLaunch(TargetInfo* target)
             caster->CalculateSpellDamage(&damageInfo, m_damage, m_spellInfo, m_attackType);
     }
 
-    target->damage = damageInfo.damage;
-    target->HitInfo = damageInfo.HitInfo;
+    TargetInfo& launchedTarget = m_UniqueTargetInfo[targetIndex];
+    launchedTarget.damage = damageInfo.damage;
+    launchedTarget.HitInfo = damageInfo.HitInfo;
 }
 
 void Spell::InitializeDamageMultipliers()
@@ -3111,8 +3123,8 @@ void Spell::cast(bool skipCheck)
         TakeCastItem();
 
         // fill initial spell damage from caster for delayed casted spells
-        for (TargetList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
-            HandleDelayedSpellLaunch(&(*ihit));
+        for (size_t i = 0; i < m_UniqueTargetInfo.size(); ++i)
+            HandleDelayedSpellLaunch(i);
 
         // Okay, maps created, now prepare flags
         m_immediateHandled = false;
@@ -3144,11 +3156,11 @@ void Spell::handle_immediate()
         ProcSpellAuraTriggers();
     }
 
-    for (TargetList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
-        DoAllEffectOnTarget(&(*ihit));
+    for (size_t i = 0; i < m_UniqueTargetInfo.size(); ++i)
+        DoAllEffectOnTarget(&m_UniqueTargetInfo[i]);
 
-    for (GOTargetList::iterator ihit = m_UniqueGOTargetInfo.begin(); ihit != m_UniqueGOTargetInfo.end(); ++ihit)
-        DoAllEffectOnTarget(&(*ihit));
+    for (size_t i = 0; i < m_UniqueGOTargetInfo.size(); ++i)
+        DoAllEffectOnTarget(&m_UniqueGOTargetInfo[i]);
 
     // spell is finished, perform some last features of the spell here
     _handle_finish_phase();
@@ -3171,26 +3183,28 @@ uint64 Spell::handle_delayed(uint64 t_offset)
     }
 
     // now recheck units targeting correctness (need before any effects apply to prevent adding immunity at first effect not allow apply second spell effect and similar cases)
-    for (TargetList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (size_t i = 0; i < m_UniqueTargetInfo.size(); ++i)
     {
-        if (!ihit->processed)
+        TargetInfo& target = m_UniqueTargetInfo[i];
+        if (!target.processed)
         {
-            if (ihit->timeDelay <= t_offset)
-                DoAllEffectOnTarget(&(*ihit));
-            else if (next_time == 0 || ihit->timeDelay < next_time)
-                next_time = ihit->timeDelay;
+            if (target.timeDelay <= t_offset)
+                DoAllEffectOnTarget(&target);
+            else if (next_time == 0 || target.timeDelay < next_time)
+                next_time = target.timeDelay;
         }
     }
 
     // now recheck gameobject targeting correctness
-    for (GOTargetList::iterator ighit = m_UniqueGOTargetInfo.begin(); ighit != m_UniqueGOTargetInfo.end(); ++ighit)
+    for (size_t i = 0; i < m_UniqueGOTargetInfo.size(); ++i)
     {
-        if (!ighit->processed)
+        GOTargetInfo& target = m_UniqueGOTargetInfo[i];
+        if (!target.processed)
         {
-            if (ighit->timeDelay <= t_offset)
-                DoAllEffectOnTarget(&(*ighit));
-            else if (next_time == 0 || ighit->timeDelay < next_time)
-                next_time = ighit->timeDelay;
+            if (target.timeDelay <= t_offset)
+                DoAllEffectOnTarget(&target);
+            else if (next_time == 0 || target.timeDelay < next_time)
+                next_time = target.timeDelay;
         }
     }
     // All targets passed - need finish phase
@@ -3239,8 +3253,8 @@ void Spell::_handle_immediate_phase()
     m_diminishGroup = DIMINISHING_NONE;
 
     // process items
-    for (ItemTargetList::iterator ihit = m_UniqueItemInfo.begin(); ihit != m_UniqueItemInfo.end(); ++ihit)
-        DoAllEffectOnTarget(&(*ihit));
+    for (size_t i = 0; i < m_UniqueItemInfo.size(); ++i)
+        DoAllEffectOnTarget(&m_UniqueItemInfo[i]);
 
     // process ground
     for (int j = 0; j < MAX_EFFECT_INDEX; ++j)
@@ -591,9 +591,11 @@ class Spell
             uint8 effectMask;
         };
 
-        typedef std::list<TargetInfo>     TargetList;
-        typedef std::list<GOTargetInfo>   GOTargetList;
-        typedef std::list<ItemTargetInfo> ItemTargetList;
+        // contiguous, effect handlers may add targets while the lists are processed,
+        // so loops that apply effects go by index and never keep element pointers across effects
+        typedef std::vector<TargetInfo>     TargetList;
+        typedef std::vector<GOTargetInfo>   GOTargetList;
+        typedef std::vector<ItemTargetInfo> ItemTargetList;
 
         TargetList     m_UniqueTargetInfo;
         GOTargetList   m_UniqueGOTargetInfo;
@@ -605,7 +607,7 @@ class Spell
         void AddGOTarget(ObjectGuid goGuid, SpellEffectIndex effIndex);
         void AddItemTarget(Item* target, SpellEffectIndex effIndex);
         void DoAllEffectOnTarget(TargetInfo* target);
-        void HandleDelayedSpellLaunch(TargetInfo* target);
+        void HandleDelayedSpellLaunch(size_t targetIndex);
         void InitializeDamageMultipliers();
         void ResetEffectDamageAndHeal();
         void DoSpellHitOnUnit(Unit* unit, uint32 effectMask, bool isReflected = false);
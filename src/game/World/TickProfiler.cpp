@@ -0,0 +1,227 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/TickProfiler.h"
+#include "Log.h"
+
+#include <map>
+
+INSTANTIATE_SINGLETON_1(TickProfiler);
+
+// upper bounds of the tick histogram buckets in milliseconds, the last bucket is open
+static uint32 const tickHistogramBounds[TICK_HISTOGRAM_BUCKETS - 1] = { 10, 20, 30, 40, 50, 75, 100, 150, 250, 500 };
+
+static uint32 GetTickHistogramBucket(uint32 tickTime)
+{
+    uint32 bucket = 0;
+    while (bucket < TICK_HISTOGRAM_BUCKETS - 1 && tickTime >= tickHistogramBounds[bucket])
+        ++bucket;
+    return bucket;
+}
+
+std::atomic<bool> TickProfiler::m_enabled(false);
+
+TickProfiler::TickProfiler() : m_tickTimesPos(0)
+{
+    m_tickTimes.reserve(TICK_HISTOGRAM_WINDOW);
+
+    for (uint32 i = 0; i < TICK_HISTOGRAM_BUCKETS; ++i)
+        m_histogram[i] = 0;
+}
+
+TickProfiler::~TickProfiler()
+{
+    for (std::vector<ThreadData*>::const_iterator itr = m_threads.begin(); itr != m_threads.end(); ++itr)
+        delete *itr;
+}
+
+void TickProfiler::Enable(uint32 flushInterval)
+{
+    m_flushTimer.SetInterval(flushInterval);
+    m_flushTimer.SetCurrent(0);
+    m_enabled = true;
+}
+
+void TickProfiler::Disable()
+{
+    if (!m_enabled)
+        return;
+
+    m_enabled = false;
+    WriteSamples();
+}
+
+void TickProfiler::Update(uint32 diff)
+{
+    if (!IsEnabled())
+        return;
+
+    m_flushTimer.Update(diff);
+    if (!m_flushTimer.Passed())
+        return;
+
+    m_flushTimer.SetCurrent(0);
+    WriteSamples();
+}
+
+void TickProfiler::RecordTick(uint32 tickTime)
+{
+    std::lock_guard<std::mutex> guard(m_histogramLock);
+
+    ++m_histogram[GetTickHistogramBucket(tickTime)];
+
+    if (m_tickTimes.size() < TICK_HISTOGRAM_WINDOW)
+    {
+        m_tickTimes.push_back(tickTime);
+        return;
+    }
+
+    // window full, the oldest tick leaves the histogram
+    uint32& slot = m_tickTimes[m_tickTimesPos];
+    --m_histogram[GetTickHistogramBucket(slot)];
+    slot = tickTime;
+
+    m_tickTimesPos = (m_tickTimesPos + 1) % TICK_HISTOGRAM_WINDOW;
+}
+
+void TickProfiler::GetTickHistogram(uint32 (&counts)[TICK_HISTOGRAM_BUCKETS]) const
+{
+    std::lock_guard<std::mutex> guard(m_histogramLock);
+
+    for (uint32 i = 0; i < TICK_HISTOGRAM_BUCKETS; ++i)
+        counts[i] = m_histogram[i];
+}
+
+uint32 TickProfiler::GetTickHistogramBound(uint32 bucket)
+{
+    return bucket < TICK_HISTOGRAM_BUCKETS - 1 ? tickHistogramBounds[bucket] : 0;
+}
+
+TickProfiler::ThreadData* TickProfiler::CreateThreadData()
+{
+    ThreadData* data = new ThreadData;
+
+    TickProfiler& profiler = sTickProfiler;
+    std::lock_guard<std::mutex> guard(profiler.m_threadsLock);
+    profiler.m_threads.push_back(data);
+    return data;
+}
+
+TickProfiler::ThreadData& TickProfiler::GetThreadData()
+{
+    // registered on first use, owned by the profiler so samples survive the thread
+    static thread_local ThreadData* threadData = CreateThreadData();
+    return *threadData;
+}
+
+void TickProfiler::PushFrame(char const* name)
+{
+    ThreadData& data = GetThreadData();
+
+    Frame frame;
+    frame.pathLength = data.path.size();
+    frame.childTime = 0;
+    data.frames.push_back(frame);
+
+    if (!data.path.empty())
+        data.path += ';';
+    data.path += name;
+
+    data.frames.back().start = std::chrono::steady_clock::now();
+}
+
+void TickProfiler::PushFrame(char const* name, uint32 id)
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%s %u", name, id);
+    PushFrame(buf);
+}
+
+void TickProfiler::PopFrame()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    ThreadData& data = GetThreadData();
+
+    if (data.frames.empty())
+        return;
+
+    Frame frame = data.frames.back();
+    data.frames.pop_back();
+
+    uint64 elapsed = uint64(std::chrono::duration_cast<std::chrono::microseconds>(now - frame.start).count());
+    if (!data.frames.empty())
+        data.frames.back().childTime += elapsed;
+
+    {
+        std::lock_guard<std::mutex> guard(data.samplesLock);
+        data.samples[data.path] += elapsed > frame.childTime ? elapsed - frame.childTime : 0;
+    }
+
+    data.path.resize(frame.pathLength);
+}
+
+void TickProfiler::WriteSamples()
+{
+    // merge all threads, equal stacks of different map workers are one line in the output
+    std::map<std::string, uint64> merged;
+    {
+        std::lock_guard<std::mutex> guard(m_threadsLock);
+
+        for (std::vector<ThreadData*>::const_iterator itr = m_threads.begin(); itr != m_threads.end(); ++itr)
+        {
+            std::lock_guard<std::mutex> samplesGuard((*itr)->samplesLock);
+
+            for (std::unordered_map<std::string, uint64>::const_iterator sItr = (*itr)->samples.begin(); sItr != (*itr)->samples.end(); ++sItr)
+                merged[sItr->first] += sItr->second;
+
+            (*itr)->samples.clear();
+        }
+    }
+
+    if (merged.empty())
+        return;
+
+    std::string fileName = sLog.GetLogsDir() + "tick_profile_" + Log::GetTimestampStr() + ".folded";
+    FILE* file = fopen(fileName.c_str(), "w");
+    if (!file)
+    {
+        sLog.outError("TickProfiler: can't open %s for writing", fileName.c_str());
+        return;
+    }
+
+    for (std::map<std::string, uint64>::const_iterator itr = merged.begin(); itr != merged.end(); ++itr)
+        fprintf(file, "%s " UI64FMTD "\n", itr->first.c_str(), itr->second);
+
+    fclose(file);
+
+    uint32 counts[TICK_HISTOGRAM_BUCKETS];
+    GetTickHistogram(counts);
+
+    std::string histogram;
+    for (uint32 i = 0; i < TICK_HISTOGRAM_BUCKETS; ++i)
+    {
+        char buf[32];
+        if (i < TICK_HISTOGRAM_BUCKETS - 1)
+            snprintf(buf, sizeof(buf), " <%ums:%u", tickHistogramBounds[i], counts[i]);
+        else
+            snprintf(buf, sizeof(buf), " >=%ums:%u", tickHistogramBounds[i - 1], counts[i]);
+        histogram += buf;
+    }
+
+    sLog.outString("TickProfiler: wrote %u stacks to %s, tick times:%s", uint32(merged.size()), fileName.c_str(), histogram.c_str());
+}
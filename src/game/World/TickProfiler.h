@@ -0,0 +1,135 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TICKPROFILER_H
+#define MANGOS_TICKPROFILER_H
+
+#include "Common.h"
+#include "Timer.h"
+#include "Policies/Singleton.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define TICK_HISTOGRAM_BUCKETS 11
+#define TICK_HISTOGRAM_WINDOW  1200                         // ticks in the rolling histogram, one minute at 50ms ticks
+
+/**
+ * Instrumenting profiler of the world tick, switched on at runtime by .server profile.
+ *
+ * ProfileScope objects form a per thread stack of named frames. While enabled, the self time
+ * of every frame is summed per stack and written every interval as collapsed stacks
+ * (one "frame;frame;frame microseconds" line per stack) to LogsDir, ready for flamegraph tools.
+ * Map updates run on the map worker threads and therefore show up as separate "map <id>" roots.
+ *
+ * Independent of that a rolling histogram of the last TICK_HISTOGRAM_WINDOW tick times is kept.
+ */
+class TickProfiler
+{
+    public:
+        TickProfiler();
+        ~TickProfiler();
+
+        static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+        void Enable(uint32 flushInterval);
+        void Disable();
+        uint32 GetFlushInterval() const { return uint32(m_flushTimer.GetInterval()); }
+
+        /// Called by the world thread once per tick, writes the collected stacks when the interval passed
+        void Update(uint32 diff);
+
+        void RecordTick(uint32 tickTime);
+        void GetTickHistogram(uint32 (&counts)[TICK_HISTOGRAM_BUCKETS]) const;
+        static uint32 GetTickHistogramBound(uint32 bucket);
+
+        void PushFrame(char const* name);
+        void PushFrame(char const* name, uint32 id);
+        void PopFrame();
+
+    private:
+        struct Frame
+        {
+            size_t pathLength;                              // length of the parent path
+            std::chrono::steady_clock::time_point start;
+            uint64 childTime;
+        };
+
+        struct ThreadData
+        {
+            std::string path;
+            std::vector<Frame> frames;
+
+            std::mutex samplesLock;                         // samples are taken over by the world thread
+            std::unordered_map<std::string, uint64> samples;
+        };
+
+        static ThreadData* CreateThreadData();
+
+        ThreadData& GetThreadData();
+        void WriteSamples();
+
+        static std::atomic<bool> m_enabled;
+
+        IntervalTimer m_flushTimer;
+
+        std::mutex m_threadsLock;
+        std::vector<ThreadData*> m_threads;                 // owned, map worker threads live as long as the world
+
+        mutable std::mutex m_histogramLock;
+        std::vector<uint32> m_tickTimes;
+        uint32 m_tickTimesPos;
+        uint32 m_histogram[TICK_HISTOGRAM_BUCKETS];
+};
+
+#define sTickProfiler MaNGOS::Singleton<TickProfiler>::Instance()
+
+/// Profiles the enclosing scope as a frame of the current thread's stack
+class ProfileScope
+{
+    public:
+        explicit ProfileScope(char const* name) : m_active(TickProfiler::IsEnabled())
+        {
+            if (m_active)
+                sTickProfiler.PushFrame(name);
+        }
+
+        ProfileScope(char const* name, uint32 id) : m_active(TickProfiler::IsEnabled())
+        {
+            if (m_active)
+                sTickProfiler.PushFrame(name, id);
+        }
+
+        ~ProfileScope()
+        {
+            if (m_active)
+                sTickProfiler.PopFrame();
+        }
+
+    private:
+        ProfileScope(ProfileScope const&);
+        ProfileScope& operator=(ProfileScope const&);
+
+        bool m_active;
+};
+
+#endif
@@ -100,6 +100,7 @@ World::World() : mail_timer(0), mail_timer_expires(0), m_NextDailyQuestReset(0),
     m_startTime = m_gameTime;
     m_maxActiveSessionCount = 0;
     m_maxQueuedSessionCount = 0;
+    m_updatePhaseTicks = 0;
 
     m_defaultDbcLocale = LOCALE_enUS;
     m_availableDbcLocaleMask = 0;
@@ -475,10 +476,15 @@ void World::LoadConfigSettings(bool reload)
     if (!reload)
         setConfig(CONFIG_MAPUPDATE_NUMTHREADS, "MapUpdateThreads", 5);
 
+    if (!reload)
+        setConfig(CONFIG_PATHFINDER_NUMTHREADS, "PathFinder.Threads", 2);
+
     setConfigMin(CONFIG_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_INTERVAL_MAPUPDATE));
 
+    setConfigMinMax(CONFIG_INTERVAL_GROUP_UPDATE, "GroupUpdateInterval", 0, 0, 5 * IN_MILLISECONDS);
+
     setConfig(CONFIG_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (configNoReload(reload, CONFIG_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
@@ -822,6 +828,8 @@ void World::LoadConfigSettings(bool reload)
                    enableLOS, enableHeight, getConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK) ? 1 : 0);
     sLog.outString("WORLD: VMap data directory is: %svmaps", m_dataPath.c_str());
 
+    setConfig(CONFIG_BOOL_DBC_SNAPSHOT, "DBC.Snapshot", false);
+
     setConfig(CONFIG_BOOL_MMAP_ENABLED, "mmap.enabled", true);
     std::string ignoreMapIds = sConfig.GetStringDefault("mmap.ignoreMapIds");
     MMAP::MMapFactory::preventPathfindingOnMaps(ignoreMapIds.c_str());
@@ -889,7 +897,7 @@ void World::SetInitialWorldSettings()
 
     ///- Load the DBC files
     sLog.outString("Initialize DBC data stores...");
-    LoadDBCStores(m_dataPath);
+    LoadDBCStores(m_dataPath, getConfig(CONFIG_BOOL_DBC_SNAPSHOT));
     DetectDBCLang();
     sObjectMgr.SetDBCLocaleIndex(GetDefaultDbcLocale());    // Get once for all the locale index of DBC language (console/broadcasts)
 
@@ -1377,6 +1385,8 @@ void World::DetectDBCLang()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    WorldUpdatePhaseTimer tickTimer(WUPDATE_PHASE_TOTAL);
+
     ///- Update the different timers
     for (int i = 0; i < WUPDATE_COUNT; ++i)
     {
@@ -1404,33 +1414,40 @@ void World::Update(uint32 diff)
     if (m_gameTime > m_NextMonthlyQuestReset)
         ResetMonthlyQuests();
 
-    /// <ul><li> Handle auctions when the timer has passed
-    if (m_timers[WUPDATE_AUCTIONS].Passed())
     {
-        m_timers[WUPDATE_AUCTIONS].Reset();
+        WorldUpdatePhaseTimer phaseTimer(WUPDATE_PHASE_AUCTIONS);
 
-        ///- Update mails (return old mails with item, or delete them)
-        //(tested... works on win)
-        if (++mail_timer > mail_timer_expires)
+        /// <ul><li> Handle auctions when the timer has passed
+        if (m_timers[WUPDATE_AUCTIONS].Passed())
         {
-            mail_timer = 0;
-            sObjectMgr.ReturnOrDeleteOldMails(true);
+            m_timers[WUPDATE_AUCTIONS].Reset();
+
+            ///- Update mails (return old mails with item, or delete them)
+            //(tested... works on win)
+            if (++mail_timer > mail_timer_expires)
+            {
+                mail_timer = 0;
+                sObjectMgr.ReturnOrDeleteOldMails(true);
+            }
+
+            ///- Handle expired auctions
+            sAuctionMgr.Update();
         }
 
-        ///- Handle expired auctions
-        sAuctionMgr.Update();
+        /// <li> Handle AHBot operations
+        if (m_timers[WUPDATE_AHBOT].Passed())
+        {
+            sAuctionBot.Update();
+            m_timers[WUPDATE_AHBOT].Reset();
+        }
     }
 
-    /// <li> Handle AHBot operations
-    if (m_timers[WUPDATE_AHBOT].Passed())
+    /// <li> Handle session updates
     {
-        sAuctionBot.Update();
-        m_timers[WUPDATE_AHBOT].Reset();
+        WorldUpdatePhaseTimer phaseTimer(WUPDATE_PHASE_SESSIONS);
+        UpdateSessions(diff);
     }
 
-    /// <li> Handle session updates
-    UpdateSessions(diff);
-
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
     {
@@ -1444,8 +1461,16 @@ void World::Update(uint32 diff)
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
     sMapMgr.Update(diff);
-    sBattleGroundMgr.Update(diff);
-    sOutdoorPvPMgr.Update(diff);
+
+    {
+        WorldUpdatePhaseTimer phaseTimer(WUPDATE_PHASE_BATTLEGROUNDS);
+        sBattleGroundMgr.Update(diff);
+    }
+
+    {
+        WorldUpdatePhaseTimer phaseTimer(WUPDATE_PHASE_OUTDOORPVP);
+        sOutdoorPvPMgr.Update(diff);
+    }
 
     ///- Update groups with offline leaders
     if (m_timers[WUPDATE_GROUPS].Passed())
@@ -1466,7 +1491,10 @@ void World::Update(uint32 diff)
     }
 
     // execute callbacks from sql queries that were queued recently
-    UpdateResultQueue();
+    {
+        WorldUpdatePhaseTimer phaseTimer(WUPDATE_PHASE_SQL_CALLBACKS);
+        UpdateResultQueue();
+    }
 
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
@@ -1487,7 +1515,10 @@ void World::Update(uint32 diff)
 
     /// </ul>
     ///- Move all creatures with "delayed move" and remove and delete all objects with "delayed remove"
-    sMapMgr.RemoveAllObjectsInRemoveList();
+    {
+        WorldUpdatePhaseTimer phaseTimer(WUPDATE_PHASE_REMOVE_LISTS);
+        sMapMgr.RemoveAllObjectsInRemoveList();
+    }
 
     // update the instance reset times
     sMapPersistentStateMgr.Update();
@@ -1497,6 +1528,9 @@ void World::Update(uint32 diff)
 
     // cleanup unused GridMap objects as well as VMaps
     sTerrainMgr.Update(diff);
+
+    // write collected profile stacks if enabled
+    sTickProfiler.Update(diff);
 }
 
 namespace MaNGOS
@@ -1834,6 +1868,45 @@ void World::ShutdownCancel()
     DEBUG_LOG("Server %s cancelled.", (m_ShutdownMask & SHUTDOWN_MASK_RESTART ? "restart" : "shutdown"));
 }
 
+void World::RecordUpdatePhase(WorldUpdatePhase phase, uint32 microseconds)
+{
+    WorldUpdatePhaseStats& stats = m_updatePhaseStats[phase];
+    stats.last = microseconds;
+    stats.total += microseconds;
+    if (microseconds > stats.max)
+        stats.max = microseconds;
+
+    if (phase == WUPDATE_PHASE_TOTAL)
+    {
+        ++m_updatePhaseTicks;
+        sTickProfiler.RecordTick(microseconds / IN_MILLISECONDS);
+    }
+}
+
+char const* World::GetUpdatePhaseName(WorldUpdatePhase phase)
+{
+    static char const* phaseNames[WUPDATE_PHASE_COUNT] =
+    {
+        "auctions", "sessions", "maps", "transports", "battlegrounds", "outdoorpvp", "sql callbacks", "remove lists", "tick"
+    };
+
+    return phaseNames[phase];
+}
+
+WorldUpdatePhaseTimer::~WorldUpdatePhaseTimer()
+{
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - m_start;
+    sWorld.RecordUpdatePhase(m_phase, uint32(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+}
+
+void World::ResetUpdatePhaseStats()
+{
+    for (int i = 0; i < WUPDATE_PHASE_COUNT; ++i)
+        m_updatePhaseStats[i] = WorldUpdatePhaseStats();
+
+    m_updatePhaseTicks = 0;
+}
+
 void World::UpdateSessions(uint32 /*diff*/)
 {
     ///- Add new sessions
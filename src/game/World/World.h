@@ -26,7 +26,9 @@
 #include "Common.h"
 #include "Timer.h"
 #include "Globals/SharedDefines.h"
+#include "World/TickProfiler.h"
 
+#include <chrono>
 #include <set>
 #include <list>
 #include <deque>
@@ -78,6 +80,31 @@ enum WorldTimers
     WUPDATE_COUNT       = 7
 };
 
+/// Phases of World::Update with separately measured run time
+enum WorldUpdatePhase
+{
+    WUPDATE_PHASE_AUCTIONS      = 0,                        // auction expiration, old mails and AHBot
+    WUPDATE_PHASE_SESSIONS      = 1,                        // thread unsafe opcodes
+    WUPDATE_PHASE_MAPS          = 2,                        // map updates, until the last map is done
+    WUPDATE_PHASE_TRANSPORTS    = 3,
+    WUPDATE_PHASE_BATTLEGROUNDS = 4,
+    WUPDATE_PHASE_OUTDOORPVP    = 5,
+    WUPDATE_PHASE_SQL_CALLBACKS = 6,
+    WUPDATE_PHASE_REMOVE_LISTS  = 7,                        // delayed moves and removals of all maps
+    WUPDATE_PHASE_TOTAL         = 8,                        // whole World::Update
+    WUPDATE_PHASE_COUNT         = 9
+};
+
+/// Run time of one World::Update phase in microseconds
+struct WorldUpdatePhaseStats
+{
+    WorldUpdatePhaseStats() : last(0), max(0), total(0) {}
+
+    uint32 last;
+    uint32 max;
+    uint64 total;
+};
+
 /// Configuration elements
 enum eConfigUInt32Values
 {
@@ -85,7 +112,9 @@ enum eConfigUInt32Values
     CONFIG_INTERVAL_SAVE,
     CONFIG_INTERVAL_GRIDCLEAN,
     CONFIG_INTERVAL_MAPUPDATE,
+    CONFIG_INTERVAL_GROUP_UPDATE,
     CONFIG_MAPUPDATE_NUMTHREADS,
+    CONFIG_PATHFINDER_NUMTHREADS,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_PORT_WORLD,
     CONFIG_GAME_TYPE,
@@ -338,6 +367,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_PLAYER_COMMANDS,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
+    CONFIG_BOOL_DBC_SNAPSHOT,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -453,6 +483,13 @@ class World
         uint32 GetMaxQueuedSessionCount() const { return m_maxQueuedSessionCount; }
         uint32 GetMaxActiveSessionCount() const { return m_maxActiveSessionCount; }
 
+        /// World::Update phase timings, shown by .server tick
+        void RecordUpdatePhase(WorldUpdatePhase phase, uint32 microseconds);
+        static char const* GetUpdatePhaseName(WorldUpdatePhase phase);
+        WorldUpdatePhaseStats const& GetUpdatePhaseStats(WorldUpdatePhase phase) const { return m_updatePhaseStats[phase]; }
+        uint64 GetUpdatePhaseTicks() const { return m_updatePhaseTicks; }
+        void ResetUpdatePhaseStats();
+
         /// Get the active session server limit (or security level limitations)
         uint32 GetPlayerAmountLimit() const { return m_playerLimit >= 0 ? m_playerLimit : 0; }
         AccountTypes GetPlayerSecurityLimit() const { return m_playerLimit <= 0 ? AccountTypes(-m_playerLimit) : SEC_PLAYER; }
@@ -628,6 +665,8 @@ class World
         time_t m_startTime;
         time_t m_gameTime;
         IntervalTimer m_timers[WUPDATE_COUNT];
+        WorldUpdatePhaseStats m_updatePhaseStats[WUPDATE_PHASE_COUNT];
+        uint64 m_updatePhaseTicks;
         uint32 mail_timer;
         uint32 mail_timer_expires;
 
@@ -690,5 +729,20 @@ class World
 extern uint32 realmID;
 
 #define sWorld MaNGOS::Singleton<World>::Instance()
+
+/// Measures the scope as one World::Update phase, also a frame of the tick profiler
+class WorldUpdatePhaseTimer
+{
+    public:
+        explicit WorldUpdatePhaseTimer(WorldUpdatePhase phase)
+            : m_phase(phase), m_start(std::chrono::steady_clock::now()), m_profileScope(World::GetUpdatePhaseName(phase)) {}
+        ~WorldUpdatePhaseTimer();
+
+    private:
+        WorldUpdatePhase m_phase;
+        std::chrono::steady_clock::time_point m_start;
+        ProfileScope m_profileScope;
+};
+
 #endif
 /// @}
@@ -22,14 +22,19 @@
 #include "VMapDefinitions.h"
 
 #include <set>
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 using G3D::Vector3;
 using G3D::AABox;
 using G3D::inf;
 using std::pair;
 
+#define MAX_CACHED_MODEL_VERTICES (16 * 1024 * 1024)        // ~200MB of raw M2 vertices
+
 template<> struct BoundsTrait<VMAP::ModelSpawn*>
 {
     static void getBounds(const VMAP::ModelSpawn* const& obj, G3D::AABox& out) { out = obj->getBounds(); }
@@ -52,12 +57,16 @@ namespace VMAP
 
     //=================================================================
 
-    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
+    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads)
     {
         iCurrentUniqueNameId = 0;
         iFilterMethod = nullptr;
         iSrcDir = pSrcDirName;
         iDestDir = pDestDirName;
+        iThreads = threads ? threads : 1;
+        iModelVertexCount = 0;
+        iNextJob = 0;
+        iFailed = false;
         // mkdir(iDestDir);
         // init();
     }
@@ -67,136 +76,331 @@ namespace VMAP
         // delete iCoordModelMapping;
     }
 
+    static uint32 getMSTimeSince(std::chrono::steady_clock::time_point start)
+    {
+        return uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
     bool TileAssembler::convertWorld2()
     {
+        std::chrono::steady_clock::time_point stageStart = std::chrono::steady_clock::now();
+
         bool success = readMapSpawns();
         if (!success)
             return false;
 
-        // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        printf("Reading spawns took %u ms\n", getMSTimeSince(stageStart));
+
+        // export Map data, maps are independent and converted on all threads, each one holds one map tree at once
+        stageStart = std::chrono::steady_clock::now();
+
+        std::vector<MapData::iterator> maps;
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+            maps.push_back(map_iter);
+
+        iNextJob = 0;
+        iFailed = false;
+
+        uint32 threads = std::min(iThreads, uint32(maps.size()));
+        if (threads > 1)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
+            std::vector<std::thread> workers;
+            for (uint32 i = 0; i < threads; ++i)
+                workers.push_back(std::thread(&TileAssembler::convertMapsWorker, this, &maps));
+
+            for (uint32 i = 0; i < threads; ++i)
+                workers[i].join();
+        }
+        else
+            convertMapsWorker(&maps);
+
+        success = !iFailed;
+
+        // not needed for the model files anymore
+        iModelVertices.clear();
+        iModelVertexCount = 0;
+
+        printf("Converting %u maps took %u ms\n", uint32(maps.size()), getMSTimeSince(stageStart));
+
+        // add an object models, listed in temp_gameobject_models file
+        stageStart = std::chrono::steady_clock::now();
+        exportGameobjectModels();
+        printf("Exporting gameobject models took %u ms\n", getMSTimeSince(stageStart));
+
+        // export objects
+        stageStart = std::chrono::steady_clock::now();
+        if (!convertModelFiles())
+            success = false;
+        printf("Converting %u model files took %u ms\n", uint32(spawnedModelFiles.size()), getMSTimeSince(stageStart));
+
+        // cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        return success;
+    }
+
+    void TileAssembler::convertMapsWorker(std::vector<MapData::iterator> const* maps)
+    {
+        while (!iFailed)
+        {
+            uint32 index = iNextJob++;
+            if (index >= maps->size())
+                break;
+
+            MapData::iterator map_iter = (*maps)[index];
+            if (!convertMap(map_iter->first, *map_iter->second))
+                iFailed = true;
+        }
+    }
+
+    bool TileAssembler::convertMap(uint32 mapID, MapSpawns& spawns)
+    {
+        bool success = true;
+
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        std::set<std::string> modelFiles;
+        UniqueEntryMap::iterator entry;
+        printf("Calculating model bounds for map %u...\n", mapID);
+        for (entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                        break;
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    // TODO: remove extractor hack and uncomment below line:
-                    // entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
+                if (!calculateTransformedBound(entry->second))
+                    break;
+            }
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
+            {
+                // TODO: remove extractor hack and uncomment below line:
+                // entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
             }
+            mapSpawns.push_back(&(entry->second));
+            modelFiles.insert(entry->second.name);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(iLock);
+            spawnedModelFiles.insert(modelFiles.begin(), modelFiles.end());
+        }
+
+        printf("Creating map tree for map %u...\n", mapID);
+        BIH pTree;
+        pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
 
-            printf("Creating map tree...\n");
-            BIH pTree;
-            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i = 0; i < mapSpawns.size(); ++i)
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i = 0; i < mapSpawns.size(); ++i)
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << mapID << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
+        }
+
+        // general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns.TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+        for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+        {
+            success = ModelSpawn::writeToFile(mapfile, spawns.UniqueEntries[glob->second]);
+        }
+
+        fclose(mapfile);
+
+        // <====
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap& tileEntries = spawns.TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn& spawn = spawns.UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN)           // WDT spawn, saved as tile 65/65 currently...
+                continue;
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << "/" << std::setw(3) << mapID << "_";
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
+            FILE* tilefile = fopen(tilefilename.str().c_str(), "wb");
+            if (!tilefile)
             {
+                printf("Cannot open %s\n", tilefilename.str().c_str());
                 success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
                 break;
             }
-
-            // general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-            for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+            // file header
+            if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
+            // write number of tile spawns
+            if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+            // write tile spawns
+            for (uint32 s = 0; s < nSpawns; ++s)
             {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                if (s)
+                    ++tile;
+                const ModelSpawn& spawn2 = spawns.UniqueEntries[tile->second];
+                success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                // MapTree nodes to update when loading tile:
+                std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
             }
+            fclose(tilefile);
+        }
 
-            fclose(mapfile);
+        return success;
+    }
+
+    // FNV-1a of the whole raw model file
+    static bool hashRawFile(const std::string& pFilename, uint64& hash)
+    {
+        FILE* rf = fopen(pFilename.c_str(), "rb");
+        if (!rf)
+            return false;
 
-            // <====
+        hash = 14695981039346656037ULL;
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap& tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        unsigned char buffer[64 * 1024];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), rf)) > 0)
+        {
+            for (size_t i = 0; i < read; ++i)
             {
-                const ModelSpawn& spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN)           // WDT spawn, saved as tile 65/65 currently...
-                    continue;
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << "/" << std::setw(3) << map_iter->first << "_";
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
-                FILE* tilefile = fopen(tilefilename.str().c_str(), "wb");
-                // file header
-                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
-                // write number of tile spawns
-                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-                // write tile spawns
-                for (uint32 s = 0; s < nSpawns; ++s)
-                {
-                    if (s)
-                        ++tile;
-                    const ModelSpawn& spawn2 = map_iter->second->UniqueEntries[tile->second];
-                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                    // MapTree nodes to update when loading tile:
-                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-                }
-                fclose(tilefile);
+                hash ^= buffer[i];
+                hash *= 1099511628211ULL;
             }
-            // break; // test, extract only first map; TODO: remvoe this line
         }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
+        bool success = ferror(rf) == 0;
+        fclose(rf);
+        return success;
+    }
 
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+    bool TileAssembler::convertModelFiles()
+    {
+        std::string hashFilename = iDestDir + "/" + MODEL_HASHES;
+
+        // the hashes only describe the raw files, models written by another assembler format are all converted again
+        std::map<std::string, uint64> oldHashes;
+        if (FILE* hashFile = fopen(hashFilename.c_str(), "r"))
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
+            char magic[16];
+            unsigned int version;
+            if (fscanf(hashFile, "%15s %u", magic, &version) == 2 && strcmp(magic, VMAP_MAGIC) == 0 && version == MODEL_HASHES_VERSION)
             {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
+                char name[512];
+                unsigned long long hash;
+                while (fscanf(hashFile, "%llx %511s", &hash, name) == 2)
+                    oldHashes[name] = uint64(hash);
             }
+            fclose(hashFile);
         }
 
-        // cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        std::cout << "\nConverting Model Files" << std::endl;
+
+        // models not reached by a failed run keep their entry, their files are as the hash says
+        std::vector<std::string> files(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        std::map<std::string, uint64> hashes(oldHashes);
+        std::atomic<uint32> reused(0);
+
+        iNextJob = 0;
+        iFailed = false;
+
+        uint32 threads = std::min(iThreads, uint32(files.size()));
+        if (threads > 1)
         {
-            delete map_iter->second;
+            std::vector<std::thread> workers;
+            for (uint32 i = 0; i < threads; ++i)
+                workers.push_back(std::thread(&TileAssembler::convertModelFilesWorker, this, &files, &hashes, &oldHashes, &reused));
+
+            for (uint32 i = 0; i < threads; ++i)
+                workers[i].join();
+        }
+        else
+            convertModelFilesWorker(&files, &hashes, &oldHashes, &reused);
+
+        if (FILE* hashFile = fopen(hashFilename.c_str(), "w"))
+        {
+            fprintf(hashFile, "%s %u\n", VMAP_MAGIC, MODEL_HASHES_VERSION);
+            for (std::map<std::string, uint64>::const_iterator itr = hashes.begin(); itr != hashes.end(); ++itr)
+                fprintf(hashFile, "%016llx %s\n", (unsigned long long)itr->second, itr->first.c_str());
+            fclose(hashFile);
+        }
+
+        if (reused)
+            printf("%u of %u model files are unchanged since the last run\n", uint32(reused), uint32(files.size()));
+
+        return !iFailed;
+    }
+
+    void TileAssembler::convertModelFilesWorker(std::vector<std::string> const* files, std::map<std::string, uint64>* hashes,
+                                                std::map<std::string, uint64> const* oldHashes, std::atomic<uint32>* reused)
+    {
+        while (!iFailed)
+        {
+            uint32 index = iNextJob++;
+            if (index >= files->size())
+                break;
+
+            std::string const& mfile = (*files)[index];
+
+            // names without whitespace only, anything else is converted on every run
+            uint64 hash = 0;
+            bool hashed = mfile.find_first_of(" \t\r\n") == std::string::npos && hashRawFile(iSrcDir + "/" + mfile, hash);
+
+            if (hashed)
+            {
+                std::map<std::string, uint64>::const_iterator itr = oldHashes->find(mfile);
+                if (itr != oldHashes->end() && itr->second == hash)
+                {
+                    if (FILE* vmo = fopen((iDestDir + "/" + mfile + ".vmo").c_str(), "rb"))
+                    {
+                        fclose(vmo);
+                        ++*reused;
+
+                        std::lock_guard<std::mutex> guard(iLock);
+                        (*hashes)[mfile] = hash;
+                        continue;
+                    }
+                }
+            }
+
+            printf("Converting %s\n", mfile.c_str());
+            if (!convertRawFile(mfile))
+            {
+                printf("error converting %s\n", mfile.c_str());
+
+                std::lock_guard<std::mutex> guard(iLock);
+                hashes->erase(mfile);
+                iFailed = true;
+                break;
+            }
+
+            std::lock_guard<std::mutex> guard(iLock);
+            if (hashed)
+                (*hashes)[mfile] = hash;
+            else
+                hashes->erase(mfile);
         }
-        return success;
     }
 
     bool TileAssembler::readMapSpawns()
@@ -246,11 +450,11 @@ namespace VMAP
         modelPosition.iScale = spawn.iScale;
         modelPosition.init();
 
-        WorldModel_Raw raw_model;
-        if (!raw_model.Read(modelFilename.c_str()))
+        RawModelVerticesPtr raw_vertices = getModelVertices(spawn.name);
+        if (!raw_vertices)
             return false;
 
-        uint32 groups = raw_model.groupsArray.size();
+        uint32 groups = raw_vertices->size();
         if (groups != 1)
             printf("Warning: '%s' does not seem to be a M2 model!\n", modelFilename.c_str());
 
@@ -258,11 +462,11 @@ namespace VMAP
         bool boundEmpty = true;
         for (uint32 g = 0; g < groups; ++g) // should be only one for M2 files...
         {
-            std::vector<Vector3>& vertices = raw_model.groupsArray[g].vertexArray;
+            std::vector<Vector3> const& vertices = (*raw_vertices)[g];
 
             if (vertices.empty())
             {
-                std::cout << "error: model '" << spawn.name << "' has no geometry!" << std::endl;
+                printf("error: model '%s' has no geometry!\n", spawn.name.c_str());
                 continue;
             }
 
@@ -281,6 +485,43 @@ namespace VMAP
         return true;
     }
 
+    RawModelVerticesPtr TileAssembler::getModelVertices(const std::string& pModelFilename)
+    {
+        {
+            std::lock_guard<std::mutex> guard(iLock);
+            std::map<std::string, RawModelVerticesPtr>::const_iterator itr = iModelVertices.find(pModelFilename);
+            if (itr != iModelVertices.end())
+                return itr->second;
+        }
+
+        // read outside of the lock, another thread may read the same model meanwhile
+        WorldModel_Raw raw_model;
+        if (!raw_model.Read((iSrcDir + "/" + pModelFilename).c_str()))
+            return RawModelVerticesPtr();
+
+        std::shared_ptr<RawModelVertices> vertices(new RawModelVertices(raw_model.groupsArray.size()));
+        uint32 vertexCount = 0;
+        for (uint32 g = 0; g < raw_model.groupsArray.size(); ++g)
+        {
+            (*vertices)[g].swap(raw_model.groupsArray[g].vertexArray);
+            vertexCount += (*vertices)[g].size();
+        }
+
+        std::lock_guard<std::mutex> guard(iLock);
+
+        // bounded memory, continents spawn most models again anyway
+        if (iModelVertexCount + vertexCount > MAX_CACHED_MODEL_VERTICES)
+        {
+            iModelVertices.clear();
+            iModelVertexCount = 0;
+        }
+
+        std::pair<std::map<std::string, RawModelVerticesPtr>::iterator, bool> res = iModelVertices.insert(std::make_pair(pModelFilename, RawModelVerticesPtr(vertices)));
+        if (res.second)
+            iModelVertexCount += vertexCount;
+        return res.first->second;
+    }
+
     struct WMOLiquidHeader
     {
         int xverts, yverts, xtiles, ytiles;
@@ -23,6 +23,10 @@
 #include <G3D/Matrix3.h>
 #include <map>
 #include <set>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "ModelInstance.h"
 #include "WorldModel.h"
@@ -88,6 +92,10 @@ namespace VMAP
         bool Read(const char* path);
     };
 
+    // vertices of all groups of a raw model file
+    typedef std::vector<std::vector<G3D::Vector3> > RawModelVertices;
+    typedef std::shared_ptr<RawModelVertices const> RawModelVerticesPtr;
+
     class TileAssembler
     {
         private:
@@ -98,9 +106,27 @@ namespace VMAP
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
+            uint32 iThreads;
+
+            // M2 models are spawned thousands of times, their raw file is read once for all bounds
+            std::mutex iLock;                               // guards the members below while maps are converted
+            std::map<std::string, RawModelVerticesPtr> iModelVertices;
+            uint32 iModelVertexCount;
+
+            std::atomic<uint32> iNextJob;
+            std::atomic<bool> iFailed;
+
+            bool convertMap(uint32 mapID, MapSpawns& spawns);
+            void convertMapsWorker(std::vector<MapData::iterator> const* maps);
+            RawModelVerticesPtr getModelVertices(const std::string& pModelFilename);
+
+            // model files are only converted again if their raw file changed since the last run
+            bool convertModelFiles();
+            void convertModelFilesWorker(std::vector<std::string> const* files, std::map<std::string, uint64>* hashes,
+                                         std::map<std::string, uint64> const* oldHashes, std::atomic<uint32>* reused);
 
         public:
-            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
+            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads = 1);
             virtual ~TileAssembler();
 
             bool convertWorld2();
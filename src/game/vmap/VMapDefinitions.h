@@ -26,6 +26,8 @@ namespace VMAP
     const char VMAP_MAGIC[] = "VMAP_6.0";                   // used in final vmap files
     const char RAW_VMAP_MAGIC[] = "VMAPs05";                // used in extracted vmap files with raw data
     const char GAMEOBJECT_MODELS[] = "temp_gameobject_models";
+    const char MODEL_HASHES[] = "model_hashes";             // raw file hash of every converted model, read by the next assembler run
+    const unsigned int MODEL_HASHES_VERSION = 1;            // raise when WorldModel files are written differently with the same VMAP_MAGIC
 
     // defined in TileAssembler.cpp currently...
     bool readChunk(FILE* rf, char* dest, const char* compare, uint32 len);
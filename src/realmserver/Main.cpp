@@ -23,6 +23,7 @@
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
 #include "Realms/RealmList.h"
+#include "Server/AuthWorkerPool.h"
                                            
 #include "Config/Config.h"
 #include "Log.h"
@@ -71,10 +72,13 @@ void ServiceStatusWatcher(boost::system::error_code const& error);
 bool StartDB();
 void SignalHandler(const boost::system::error_code& error, int signalNumber);
 void KeepDatabaseAliveHandler(const boost::system::error_code& error);
+void DatabaseCallbackHandler(const boost::system::error_code& error);
 
 boost::asio::io_service* _ioService;
 boost::asio::deadline_timer* _dbPingTimer;
 uint32 _dbPingInterval;
+boost::asio::deadline_timer* _dbCallbackTimer;
+uint32 _dbCallbackInterval;
 
 DatabaseType LoginDatabase;                                 ///< Accessor to the realm server database
 
@@ -148,6 +152,9 @@ int main(int argc, char *argv[])
     // Dead string of code. Need to update AuthSocket for this to work.
     std::string bind_ip = sConfig.GetStringDefault("BindIP", "0.0.0.0");
 
+    ///- Start the workers for the SRP6 calculations before accepting connections
+    sAuthWorkerPool->Start(sConfig.GetIntDefault("AuthWorkerThreads", 2));
+
     // FIXME - more intelligent selection of thread count is needed here.  config option?
     MaNGOS::Listener<AuthSocket> listener(rmport, 1);
 
@@ -210,6 +217,12 @@ int main(int argc, char *argv[])
     _dbPingTimer->expires_from_now(boost::posix_time::minutes(_dbPingInterval));
     _dbPingTimer->async_wait(KeepDatabaseAliveHandler);
 
+    // Enabled a timed callback for delivering the async login database results to the sockets
+    _dbCallbackInterval = sConfig.GetIntDefault("DatabaseCallbackInterval", 10);
+    _dbCallbackTimer = new boost::asio::deadline_timer(*_ioService);
+    _dbCallbackTimer->expires_from_now(boost::posix_time::milliseconds(_dbCallbackInterval));
+    _dbCallbackTimer->async_wait(DatabaseCallbackHandler);
+
     #ifdef _WIN32
     if (m_ServiceStatus != -1)
     {
@@ -222,15 +235,19 @@ int main(int argc, char *argv[])
     _ioService->run();
 
     _dbPingTimer->cancel();
+    _dbCallbackTimer->cancel();
 
     ///- Wait for the delay thread to exit
     LoginDatabase.HaltDelayThread();
 
+    sAuthWorkerPool->Stop();
+
     sLog.outString("Halting process...");
 
     signals.cancel();
 
     delete _dbPingTimer;
+    delete _dbCallbackTimer;
     delete _ioService;
     return 0;
 }
@@ -281,6 +298,17 @@ void KeepDatabaseAliveHandler(const boost::system::error_code& error)
     }
 }
 
+void DatabaseCallbackHandler(const boost::system::error_code& error)
+{
+    if (!error)
+    {
+        LoginDatabase.ProcessResultQueue();
+
+        _dbCallbackTimer->expires_from_now(boost::posix_time::milliseconds(_dbCallbackInterval));
+        _dbCallbackTimer->async_wait(DatabaseCallbackHandler);
+    }
+}
+
 #ifdef _WIN32
 void ServiceStatusWatcher(boost::system::error_code const& error)
 {
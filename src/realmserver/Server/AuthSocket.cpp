@@ -27,6 +27,7 @@
 #include "RealmList.h"
 #include "AuthSocket.h"
 #include "AuthCodes.h"
+#include "AuthWorkerPool.h"
 
 #include <openssl/md5.h>
 //#include "Util.h" -- for commented utf8ToUpperOnlyLatin
@@ -155,7 +156,7 @@ typedef struct AuthHandler
 
 /// Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket(boost::asio::io_service &service, std::function<void (Socket *)> closeHandler)
-    : Socket(service, closeHandler), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER)
+    : Socket(service, closeHandler), m_service(service), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER)
 {
     N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
     g.SetDword(7);
@@ -340,8 +341,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -353,155 +352,199 @@ bool AuthSocket::_HandleLogonChallenge()
     _safelogin = _login;
     LoginDatabase.escape_string(_safelogin);
 
+    _localizationName.resize(4);
+    for (int i = 0; i < 4; ++i)
+        _localizationName[i] = ch->country[4 - i - 1];
+
+    BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str(), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
+
+    ///- Verify that this IP is not in the ip_banned table, the answer is sent from the result handler
+    // No SQL injection possible (paste the IP address as passed by the socket)
+    return LoginDatabase.AsyncPQuery(&AuthSocket::_DatabaseCallback, shared<AuthSocket>(), &AuthSocket::_HandleIpBanResult,
+                                     "SELECT unbandate FROM ip_banned WHERE "
+                                     //    permanent                    still banned
+                                     "(unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str());
+}
+
+/// Continue a database request on the network thread owning the socket
+void AuthSocket::_DatabaseCallback(QueryResult* result, std::shared_ptr<AuthSocket> socket, ResultHandler handler)
+{
+    socket->m_service.post([socket, result, handler]() { ((*socket).*handler)(result); });
+}
+
+void AuthSocket::_SendLogonChallengeError(uint8 error)
+{
+    ByteBuffer pkt;
     pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
     pkt << (uint8) 0x00;
+    pkt << (uint8) error;
+    Write((const char *)pkt.contents(), pkt.size());
+}
+
+void AuthSocket::_HandleIpBanResult(QueryResult* result)
+{
+    if (IsClosed())
+    {
+        delete result;
+        return;
+    }
 
-    ///- Verify that this IP is not in the ip_banned table
-    // No SQL injection possible (paste the IP address as passed by the socket)
-    QueryResult* result = LoginDatabase.PQuery("SELECT unbandate FROM ip_banned WHERE "
-                          //    permanent                    still banned
-                          "(unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str());
     if (result)
     {
-        pkt << (uint8)WOW_FAIL_BANNED;
         BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", m_address.c_str());
+        _SendLogonChallengeError(WOW_FAIL_BANNED);
         delete result;
+        return;
     }
-    else
+
+    ///- Get the account details and an active ban from the account tables
+    // No SQL injection (escaped user name)
+    if (!LoginDatabase.AsyncPQuery(&AuthSocket::_DatabaseCallback, shared<AuthSocket>(), &AuthSocket::_HandleAccountResult,
+                                   "SELECT a.sha_pass_hash, a.id, a.locked, a.last_ip, a.gmlevel, a.v, a.s, ab.bandate, ab.unbandate FROM account a "
+                                   "LEFT JOIN account_banned ab ON ab.id = a.id AND ab.active = 1 AND (ab.unbandate > UNIX_TIMESTAMP() OR ab.unbandate = ab.bandate) "
+                                   "WHERE a.username = '%s'", _safelogin.c_str()))
+        Close();
+}
+
+void AuthSocket::_HandleAccountResult(QueryResult* result)
+{
+    if (IsClosed())
     {
-        ///- Get the account details from the account table
-        // No SQL injection (escaped user name)
+        delete result;
+        return;
+    }
 
-        result = LoginDatabase.PQuery("SELECT sha_pass_hash,id,locked,last_ip,gmlevel,v,s FROM account WHERE username = '%s'", _safelogin.c_str());
-        if (result)
-        {
-            ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-            bool locked = false;
-            if ((*result)[2].GetUInt8() == 1)               // if ip is locked
-            {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), (*result)[3].GetString());
-                DEBUG_LOG("[AuthChallenge] Player address is '%s'", m_address.c_str());
-                if (strcmp((*result)[3].GetString(), m_address.c_str()))
-                {
-                    DEBUG_LOG("[AuthChallenge] Account IP differs");
-                    pkt << (uint8) WOW_FAIL_SUSPENDED;
-                    locked = true;
-                }
-                else
-                {
-                    DEBUG_LOG("[AuthChallenge] Account IP matches");
-                }
-            }
-            else
-            {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
-            }
+    if (!result)                                            // no account
+    {
+        _SendLogonChallengeError(WOW_FAIL_UNKNOWN_ACCOUNT);
+        return;
+    }
 
-            if (!locked)
-            {
-                ///- If the account is banned, reject the logon attempt
-                QueryResult* banresult = LoginDatabase.PQuery("SELECT bandate,unbandate FROM account_banned WHERE "
-                                         "id = %u AND active = 1 AND (unbandate > UNIX_TIMESTAMP() OR unbandate = bandate)", (*result)[1].GetUInt32());
-                if (banresult)
-                {
-                    if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                    {
-                        pkt << (uint8) WOW_FAIL_BANNED;
-                        BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
-                    }
-                    else
-                    {
-                        pkt << (uint8) WOW_FAIL_SUSPENDED;
-                        BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
-                    }
-
-                    delete banresult;
-                }
-                else
-                {
-                    ///- Get the password from the account table, upper it, and make the SRP6 calculation
-                    std::string rI = (*result)[0].GetCppString();
-
-                    ///- Don't calculate (v, s) if there are already some in the database
-                    std::string databaseV = (*result)[5].GetCppString();
-                    std::string databaseS = (*result)[6].GetCppString();
-
-                    DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
-
-                    // multiply with 2, bytes are stored as hexstring
-                    if (databaseV.size() != s_BYTE_SIZE * 2 || databaseS.size() != s_BYTE_SIZE * 2)
-                        _SetVSFields(rI);
-                    else
-                    {
-                        s.SetHexStr(databaseS.c_str());
-                        v.SetHexStr(databaseV.c_str());
-                    }
-
-                    b.SetRand(19 * 8);
-                    BigNumber gmod = g.ModExp(b, N);
-                    B = ((v * 3) + gmod) % N;
-
-                    MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
-
-                    BigNumber unk3;
-                    unk3.SetRand(16 * 8);
-
-                    ///- Fill the response packet with the result
-                    pkt << uint8(WOW_SUCCESS);
-
-                    // B may be calculated < 32B so we force minimal length to 32B
-                    pkt.append(B.AsByteArray(32), 32);      // 32 bytes
-                    pkt << uint8(1);
-                    pkt.append(g.AsByteArray(), 1);
-                    pkt << uint8(32);
-                    pkt.append(N.AsByteArray(32), 32);
-                    pkt.append(s.AsByteArray(), s.GetNumBytes());// 32 bytes
-                    pkt.append(unk3.AsByteArray(16), 16);
-                    uint8 securityFlags = 0;
-                    pkt << uint8(securityFlags);            // security flags (0x0...0x04)
-
-                    if (securityFlags & 0x01)               // PIN input
-                    {
-                        pkt << uint32(0);
-                        pkt << uint64(0) << uint64(0);      // 16 bytes hash?
-                    }
-
-                    if (securityFlags & 0x02)               // Matrix input
-                    {
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint64(0);
-                    }
-
-                    if (securityFlags & 0x04)               // Security token input
-                    {
-                        pkt << uint8(1);
-                    }
-
-                    uint8 secLevel = (*result)[4].GetUInt8();
-                    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
-
-                    _localizationName.resize(4);
-                    for (int i = 0; i < 4; ++i)
-                        _localizationName[i] = ch->country[4 - i - 1];
-
-                    BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str(), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
-
-                    ///- All good, await client's proof
-                    _status = STATUS_LOGON_PROOF;
-                }
-            }
+    ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+    if ((*result)[2].GetUInt8() == 1)                       // if ip is locked
+    {
+        DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), (*result)[3].GetString());
+        DEBUG_LOG("[AuthChallenge] Player address is '%s'", m_address.c_str());
+        if (strcmp((*result)[3].GetString(), m_address.c_str()))
+        {
+            DEBUG_LOG("[AuthChallenge] Account IP differs");
+            _SendLogonChallengeError(WOW_FAIL_SUSPENDED);
             delete result;
+            return;
         }
-        else                                                // no account
+        else
         {
-            pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
+            DEBUG_LOG("[AuthChallenge] Account IP matches");
         }
     }
-    Write((const char *)pkt.contents(), pkt.size());
-    return true;
+    else
+    {
+        DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
+    }
+
+    ///- If the account is banned, reject the logon attempt
+    if (!(*result)[7].IsNULL())
+    {
+        if ((*result)[7].GetUInt64() == (*result)[8].GetUInt64())
+        {
+            _SendLogonChallengeError(WOW_FAIL_BANNED);
+            BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
+        }
+        else
+        {
+            _SendLogonChallengeError(WOW_FAIL_SUSPENDED);
+            BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
+        }
+
+        delete result;
+        return;
+    }
+
+    ///- Get the password from the account table, upper it, and make the SRP6 calculation
+    std::string rI = (*result)[0].GetCppString();
+
+    ///- Don't calculate (v, s) if there are already some in the database
+    std::string databaseV = (*result)[5].GetCppString();
+    std::string databaseS = (*result)[6].GetCppString();
+
+    uint8 secLevel = (*result)[4].GetUInt8();
+    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+
+    delete result;
+
+    DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+
+    std::shared_ptr<AuthSocket> socket = shared<AuthSocket>();
+    sAuthWorkerPool->Post([socket, rI, databaseV, databaseS]() { socket->_PrepareLogonChallenge(rI, databaseV, databaseS); });
+}
+
+void AuthSocket::_PrepareLogonChallenge(std::string const& rI, std::string const& databaseV, std::string const& databaseS)
+{
+    // multiply with 2, bytes are stored as hexstring
+    if (databaseV.size() != s_BYTE_SIZE * 2 || databaseS.size() != s_BYTE_SIZE * 2)
+        _SetVSFields(rI);
+    else
+    {
+        s.SetHexStr(databaseS.c_str());
+        v.SetHexStr(databaseV.c_str());
+    }
+
+    b.SetRand(19 * 8);
+    BigNumber gmod = g.ModExp(b, N);
+    B = ((v * 3) + gmod) % N;
+
+    MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
+
+    BigNumber unk3;
+    unk3.SetRand(16 * 8);
+
+    ///- Fill the response packet with the result
+    ByteBuffer pkt;
+    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+    pkt << (uint8) 0x00;
+    pkt << uint8(WOW_SUCCESS);
+
+    // B may be calculated < 32B so we force minimal length to 32B
+    pkt.append(B.AsByteArray(32), 32);                      // 32 bytes
+    pkt << uint8(1);
+    pkt.append(g.AsByteArray(), 1);
+    pkt << uint8(32);
+    pkt.append(N.AsByteArray(32), 32);
+    pkt.append(s.AsByteArray(), s.GetNumBytes());           // 32 bytes
+    pkt.append(unk3.AsByteArray(16), 16);
+    uint8 securityFlags = 0;
+    pkt << uint8(securityFlags);                            // security flags (0x0...0x04)
+
+    if (securityFlags & 0x01)                               // PIN input
+    {
+        pkt << uint32(0);
+        pkt << uint64(0) << uint64(0);                      // 16 bytes hash?
+    }
+
+    if (securityFlags & 0x02)                               // Matrix input
+    {
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint64(0);
+    }
+
+    if (securityFlags & 0x04)                               // Security token input
+    {
+        pkt << uint8(1);
+    }
+
+    std::shared_ptr<AuthSocket> socket = shared<AuthSocket>();
+    m_service.post([socket, pkt]()
+    {
+        if (socket->IsClosed())
+            return;
+
+        ///- All good, await client's proof
+        socket->_status = STATUS_LOGON_PROOF;
+        socket->Write((const char *)pkt.contents(), pkt.size());
+    });
 }
 
 /// Logon Proof command handler
@@ -532,16 +575,25 @@ bool AuthSocket::_HandleLogonProof()
     /// </ul>
 
     ///- Continue the SRP6 calculation based on data received from the client
+    std::shared_ptr<AuthSocket> socket = shared<AuthSocket>();
+    sAuthWorkerPool->Post([socket, lp]() { socket->_VerifyLogonProof(lp); });
+    return true;
+}
+
+void AuthSocket::_VerifyLogonProof(sAuthLogonProof_C const& lp)
+{
+    std::shared_ptr<AuthSocket> socket = shared<AuthSocket>();
+
     BigNumber A;
 
     A.SetBinary(lp.A, 32);
 
     // SRP safeguard: abort if A==0
-    if (A.isZero())
-        return false;
-
-    if ((A % N).isZero())
-        return false;
+    if (A.isZero() || (A % N).isZero())
+    {
+        m_service.post([socket]() { if (!socket->IsClosed()) socket->Close(); });
+        return;
+    }
 
     Sha1Hash sha;
     sha.UpdateBigNumbers(&A, &B, nullptr);
@@ -609,7 +661,24 @@ bool AuthSocket::_HandleLogonProof()
     M.SetBinary(sha.GetDigest(), 20);
 
     ///- Check if SRP6 results match (password is correct), else send an error
-    if (!memcmp(M.AsByteArray(), lp.M1, 20))
+    bool success = !memcmp(M.AsByteArray(), lp.M1, 20);
+    if (success)
+    {
+        ///- Finish SRP6 and send the final result to the client
+        sha.Initialize();
+        sha.UpdateBigNumbers(&A, &M, &K, nullptr);
+        sha.Finalize();
+    }
+
+    m_service.post([socket, success, sha]() { socket->_FinishLogonProof(success, sha); });
+}
+
+void AuthSocket::_FinishLogonProof(bool success, Sha1Hash const& proof)
+{
+    if (IsClosed())
+        return;
+
+    if (success)
     {
         BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
 
@@ -619,12 +688,7 @@ bool AuthSocket::_HandleLogonProof()
         LoginDatabase.PExecute("UPDATE account SET sessionkey = '%s', last_ip = '%s', last_login = NOW(), locale = '%u', failed_logins = 0 WHERE username = '%s'", K_hex, m_address.c_str(), GetLocaleByName(_localizationName), _safelogin.c_str());
         OPENSSL_free((void*)K_hex);
 
-        ///- Finish SRP6 and send the final result to the client
-        sha.Initialize();
-        sha.UpdateBigNumbers(&A, &M, &K, nullptr);
-        sha.Finalize();
-
-        SendProof(sha);
+        SendProof(proof);
 
         ///- Set _status to authed!
         _status = STATUS_AUTHED;
@@ -648,41 +712,48 @@ bool AuthSocket::_HandleLogonProof()
         if (MaxWrongPassCount > 0)
         {
             // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
+            // the select is queued behind the update on the same async connection
             LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", _safelogin.c_str());
+            LoginDatabase.AsyncPQuery(&AuthSocket::_DatabaseCallback, shared<AuthSocket>(), &AuthSocket::_HandleFailedLoginResult,
+                                      "SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str());
+        }
+    }
+}
 
-            if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
-            {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
+void AuthSocket::_HandleFailedLoginResult(QueryResult* loginfail)
+{
+    // the socket may be closed already, the ban is applied anyway
+    if (!loginfail)
+        return;
 
-                if (failed_logins >= MaxWrongPassCount)
-                {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
-
-                    if (WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
-                                               acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                  _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = m_address;
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
-                                               current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                  current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
-                }
-                delete loginfail;
-            }
+    Field* fields = loginfail->Fetch();
+    uint32 failed_logins = fields[1].GetUInt32();
+
+    uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
+    if (failed_logins >= MaxWrongPassCount)
+    {
+        uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+        bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+
+        if (WrongPassBanType)
+        {
+            uint32 acc_id = fields[0].GetUInt32();
+            LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
+                                   acc_id, WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                      _login.c_str(), WrongPassBanTime, failed_logins);
+        }
+        else
+        {
+            std::string current_ip = m_address;
+            LoginDatabase.escape_string(current_ip);
+            LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
+                                   current_ip.c_str(), WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                      current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
         }
     }
-    return true;
+    delete loginfail;
 }
 
 /// Reconnect Challenge command handler
@@ -728,14 +799,24 @@ bool AuthSocket::_HandleReconnectChallenge()
     EndianConvert(ch->build);
     _build = ch->build;
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
+    return LoginDatabase.AsyncPQuery(&AuthSocket::_DatabaseCallback, shared<AuthSocket>(), &AuthSocket::_HandleReconnectChallengeResult,
+                                     "SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
+}
+
+void AuthSocket::_HandleReconnectChallengeResult(QueryResult* result)
+{
+    if (IsClosed())
+    {
+        delete result;
+        return;
+    }
 
     // Stop if the account is not found
     if (!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
         Close();
-        return false;
+        return;
     }
 
     Field* fields = result->Fetch();
@@ -753,7 +834,6 @@ bool AuthSocket::_HandleReconnectChallenge()
     pkt.append(_reconnectProof.AsByteArray(16), 16);        // 16 bytes random
     pkt << (uint64) 0x00 << (uint64) 0x00;                  // 16 bytes zeros
     Write((const char *)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Reconnect Proof command handler
@@ -811,19 +891,37 @@ bool AuthSocket::_HandleRealmList()
 
     ReadSkip(5);
 
-    ///- Get the user id (else close the connection)
+    ///- Get the user id (else close the connection) and the amount of characters on every realm at once
     // No SQL injection (escaped user name)
+    return LoginDatabase.AsyncPQuery(&AuthSocket::_DatabaseCallback, shared<AuthSocket>(), &AuthSocket::_HandleRealmListResult,
+                                     "SELECT a.id, rc.realmid, rc.numchars FROM account a "
+                                     "LEFT JOIN realmcharacters rc ON rc.acctid = a.id WHERE a.username = '%s'", _safelogin.c_str());
+}
+
+void AuthSocket::_HandleRealmListResult(QueryResult* result)
+{
+    if (IsClosed())
+    {
+        delete result;
+        return;
+    }
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT id,sha_pass_hash FROM account WHERE username = '%s'", _safelogin.c_str());
     if (!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
         Close();
-        return false;
+        return;
+    }
+
+    RealmCharacterCounts characterCounts;
+    do
+    {
+        Field* fields = result->Fetch();
+        if (!fields[1].IsNULL())
+            characterCounts[fields[1].GetUInt32()] = fields[2].GetUInt8();
     }
+    while (result->NextRow());
 
-    uint32 id = (*result)[0].GetUInt32();
-    std::string rI = (*result)[1].GetCppString();
     delete result;
 
     ///- Update realm list if need
@@ -831,7 +929,7 @@ bool AuthSocket::_HandleRealmList()
 
     ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
-    LoadRealmlist(pkt, id);
+    LoadRealmlist(pkt, characterCounts);
 
     ByteBuffer hdr;
     hdr << (uint8) CMD_REALM_LIST;
@@ -839,11 +937,9 @@ bool AuthSocket::_HandleRealmList()
     hdr.append(pkt);
 
     Write((const char *)hdr.contents(), hdr.size());
-
-    return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
+void AuthSocket::LoadRealmlist(ByteBuffer& pkt, RealmCharacterCounts const& characterCounts)
 {
     switch (_build)
     {
@@ -856,18 +952,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
 
             for (RealmList::RealmMap::const_iterator  i = sRealmList->begin(); i != sRealmList->end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                RealmCharacterCounts::const_iterator countItr = characterCounts.find(i->second.m_ID);
+                uint8 AmountOfCharacters = countItr != characterCounts.end() ? countItr->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
@@ -917,18 +1003,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
 
             for (RealmList::RealmMap::const_iterator  i = sRealmList->begin(); i != sRealmList->end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                RealmCharacterCounts::const_iterator countItr = characterCounts.find(i->second.m_ID);
+                uint8 AmountOfCharacters = countItr != characterCounts.end() ? countItr->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
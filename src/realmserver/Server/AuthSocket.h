@@ -33,16 +33,22 @@
 #include <boost/asio.hpp>
 
 #include <functional>
+#include <memory>
+
+class QueryResult;
+struct AUTH_LOGON_PROOF_C;
 
 class AuthSocket : public MaNGOS::Socket
 {
     public:
         const static int s_BYTE_SIZE = 32;
 
+        typedef std::map<uint32, uint8> RealmCharacterCounts;
+
         AuthSocket(boost::asio::io_service &service, std::function<void (Socket *)> closeHandler);
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid);
+        void LoadRealmlist(ByteBuffer& pkt, RealmCharacterCounts const& characterCounts);
 
         bool _HandleLogonChallenge();
         bool _HandleLogonProof();
@@ -58,6 +64,27 @@ class AuthSocket : public MaNGOS::Socket
         void _SetVSFields(const std::string& rI);
 
     private:
+        typedef void (AuthSocket::*ResultHandler)(QueryResult*);
+
+        // LoginDatabase async query callback, continues with handler on the network thread of the socket
+        static void _DatabaseCallback(QueryResult* result, std::shared_ptr<AuthSocket> socket, ResultHandler handler);
+
+        // Query result handlers, always executed on the network thread and owning the result
+        void _HandleIpBanResult(QueryResult* result);
+        void _HandleAccountResult(QueryResult* result);
+        void _HandleFailedLoginResult(QueryResult* result);
+        void _HandleReconnectChallengeResult(QueryResult* result);
+        void _HandleRealmListResult(QueryResult* result);
+
+        // SRP6 calculations, executed on the auth worker pool
+        void _PrepareLogonChallenge(std::string const& rI, std::string const& databaseV, std::string const& databaseS);
+        void _VerifyLogonProof(AUTH_LOGON_PROOF_C const& lp);
+        void _FinishLogonProof(bool success, Sha1Hash const& proof);
+
+        void _SendLogonChallengeError(uint8 error);
+
+        boost::asio::io_service& m_service;                 // network thread service owning this socket
+
         enum eStatus
         {
             STATUS_CHALLENGE,
@@ -0,0 +1,53 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "AuthWorkerPool.h"
+
+void AuthWorkerPool::Start(uint32 threadCount)
+{
+    if (!threadCount || !m_threads.empty())
+        return;
+
+    m_work.reset(new boost::asio::io_service::work(m_service));
+
+    m_threads.reserve(threadCount);
+    for (uint32 i = 0; i < threadCount; ++i)
+        m_threads.push_back(std::thread([this]() { boost::system::error_code ec; this->m_service.run(ec); }));
+}
+
+void AuthWorkerPool::Stop()
+{
+    // let the threads finish the queued tasks and exit
+    m_work.reset();
+
+    // tasks posted after this point are dropped, the server is shutting down
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+void AuthWorkerPool::Post(std::function<void()> const& task)
+{
+    if (m_threads.empty())
+        task();
+    else
+        m_service.post(task);
+}
@@ -0,0 +1,335 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "DBCSnapshot.h"
+#include "DBCFileLoader.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <unordered_map>
+
+#define DBC_SNAPSHOT_MAGIC          0x53434244              // 'DBCS'
+
+struct DBCSnapshotHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint32 pointerSize;                                     // records hold pointer sized string fields
+    uint32 storeCount;
+    uint64 checksum;                                        // of everything after the header
+};
+
+struct DBCSnapshotStoreHeader
+{
+    char name[DBC_SNAPSHOT_NAME_SIZE];
+    uint64 formatHash;
+    uint64 sourceSignature;
+    uint32 recordSize;
+    uint32 indexCount;
+    uint32 recordCount;
+    uint32 stringSize;
+    uint64 recordsOffset;                                   // from the file start
+    uint64 indexOffset;
+    uint64 stringsOffset;
+};
+
+// FNV-1a
+static uint64 HashBytes(uint64 hash, void const* data, size_t size)
+{
+    if (!hash)
+        hash = 0xCBF29CE484222325ULL;
+
+    uint8 const* bytes = static_cast<uint8 const*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+// offsets of the string fields in a record, see DBCFileLoader::GetFormatRecordSize
+static void GetStringFields(char const* fmt, std::vector<uint32>& fields)
+{
+    uint32 offset = 0;
+    for (uint32 x = 0; fmt[x]; ++x)
+    {
+        switch (fmt[x])
+        {
+            case FT_FLOAT:
+                offset += sizeof(float);
+                break;
+            case FT_IND:
+            case FT_INT:
+                offset += sizeof(uint32);
+                break;
+            case FT_BYTE:
+                offset += sizeof(uint8);
+                break;
+            case FT_STRING:
+                fields.push_back(offset);
+                offset += sizeof(char*);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static void AppendPadded(std::vector<uint8>& body, void const* data, size_t size)
+{
+    uint8 const* bytes = static_cast<uint8 const*>(data);
+    body.insert(body.end(), bytes, bytes + size);
+    body.resize((body.size() + 7) & ~size_t(7));
+}
+
+DBCSnapshot::DBCSnapshot()
+{
+}
+
+bool DBCSnapshot::Open(char const* fileName)
+{
+    if (!m_file.Open(fileName))
+        return false;
+
+    DBCSnapshotHeader const* header = reinterpret_cast<DBCSnapshotHeader const*>(m_file.GetData());
+    size_t size = m_file.GetSize();
+
+    if (size < sizeof(DBCSnapshotHeader) ||
+            header->magic != DBC_SNAPSHOT_MAGIC ||
+            header->version != DBC_SNAPSHOT_VERSION ||
+            header->pointerSize != sizeof(char*) ||
+            size_t(header->storeCount) * sizeof(DBCSnapshotStoreHeader) > size - sizeof(DBCSnapshotHeader) ||
+            HashBytes(0, m_file.GetData() + sizeof(DBCSnapshotHeader), size - sizeof(DBCSnapshotHeader)) != header->checksum)
+    {
+        m_file.Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool DBCSnapshot::GetStore(char const* name, char const* fmt, uint32 recordSize, uint64 sourceSignature, Store& store) const
+{
+    if (!m_file.IsOpen())
+        return false;
+
+    uint8 const* data = m_file.GetData();
+    size_t size = m_file.GetSize();
+
+    DBCSnapshotHeader const* header = reinterpret_cast<DBCSnapshotHeader const*>(data);
+    DBCSnapshotStoreHeader const* stores = reinterpret_cast<DBCSnapshotStoreHeader const*>(data + sizeof(DBCSnapshotHeader));
+
+    for (uint32 i = 0; i < header->storeCount; ++i)
+    {
+        DBCSnapshotStoreHeader const& storeHeader = stores[i];
+        if (strncmp(storeHeader.name, name, DBC_SNAPSHOT_NAME_SIZE) != 0)
+            continue;
+
+        if (storeHeader.formatHash != HashBytes(0, fmt, strlen(fmt)) ||
+                storeHeader.recordSize != recordSize ||
+                storeHeader.sourceSignature != sourceSignature)
+            return false;
+
+        if (storeHeader.recordsOffset + uint64(storeHeader.recordCount) * recordSize > size ||
+                storeHeader.indexOffset + uint64(storeHeader.indexCount) * sizeof(uint32) > size ||
+                storeHeader.stringsOffset + storeHeader.stringSize > size)
+            return false;
+
+        store.indexCount = storeHeader.indexCount;
+        store.recordCount = storeHeader.recordCount;
+        store.records = data + storeHeader.recordsOffset;
+        store.index = reinterpret_cast<uint32 const*>(data + storeHeader.indexOffset);
+        store.strings = reinterpret_cast<char const*>(data + storeHeader.stringsOffset);
+        return true;
+    }
+
+    return false;
+}
+
+char* DBCSnapshot::ProduceData(Store const& store, char const* fmt, uint32 recordSize, char**& indexTable)
+{
+    typedef char* ptr;
+
+    char* dataTable = new char[store.recordCount * recordSize];
+    memcpy(dataTable, store.records, size_t(store.recordCount) * recordSize);
+
+    // string fields hold their offset in the string table plus one, 0 for none
+    std::vector<uint32> stringFields;
+    GetStringFields(fmt, stringFields);
+
+    for (uint32 y = 0; y < store.recordCount; ++y)
+    {
+        char* record = &dataTable[y * recordSize];
+        for (std::vector<uint32>::const_iterator itr = stringFields.begin(); itr != stringFields.end(); ++itr)
+        {
+            uintptr_t value;
+            memcpy(&value, record + *itr, sizeof(value));
+
+            char* string = value ? const_cast<char*>(store.strings) + value - 1 : nullptr;
+            memcpy(record + *itr, &string, sizeof(string));
+        }
+    }
+
+    indexTable = new ptr[store.indexCount];
+    for (uint32 i = 0; i < store.indexCount; ++i)
+    {
+        uint32 record = store.index[i];
+        indexTable[i] = record < store.recordCount ? &dataTable[record * recordSize] : nullptr;
+    }
+
+    return dataTable;
+}
+
+void DBCSnapshot::AddStore(char const* name, char const* fmt, uint32 recordSize, uint64 sourceSignature,
+                           uint32 indexCount, char const* const* indexTable, uint32 recordCount, char const* dataTable)
+{
+    PendingStore store;
+    store.name = name;
+    store.fmt = fmt;
+    store.recordSize = recordSize;
+    store.sourceSignature = sourceSignature;
+    store.indexCount = indexCount;
+    store.indexTable = indexTable;
+    store.recordCount = recordCount;
+    store.dataTable = dataTable;
+    m_pending.push_back(store);
+}
+
+bool DBCSnapshot::Write(char const* fileName) const
+{
+    DBCSnapshotHeader header;
+    header.magic = DBC_SNAPSHOT_MAGIC;
+    header.version = DBC_SNAPSHOT_VERSION;
+    header.pointerSize = sizeof(char*);
+    header.storeCount = m_pending.size();
+
+    std::vector<DBCSnapshotStoreHeader> storeHeaders(m_pending.size());
+    size_t sectionsOffset = sizeof(DBCSnapshotHeader) + storeHeaders.size() * sizeof(DBCSnapshotStoreHeader);
+
+    // sections of all stores, offsets are relative to sectionsOffset until the headers are final
+    std::vector<uint8> sections;
+
+    for (size_t i = 0; i < m_pending.size(); ++i)
+    {
+        PendingStore const& store = m_pending[i];
+        DBCSnapshotStoreHeader& storeHeader = storeHeaders[i];
+
+        if (store.name.size() >= DBC_SNAPSHOT_NAME_SIZE)
+            return false;
+
+        memset(&storeHeader, 0, sizeof(storeHeader));
+        strncpy(storeHeader.name, store.name.c_str(), DBC_SNAPSHOT_NAME_SIZE - 1);
+        storeHeader.formatHash = HashBytes(0, store.fmt, strlen(store.fmt));
+        storeHeader.sourceSignature = store.sourceSignature;
+        storeHeader.recordSize = store.recordSize;
+        storeHeader.indexCount = store.indexCount;
+        storeHeader.recordCount = store.recordCount;
+
+        // records with string offsets, equal strings of all locales are stored once
+        std::vector<uint32> stringFields;
+        GetStringFields(store.fmt, stringFields);
+
+        std::vector<char> records(store.dataTable, store.dataTable + size_t(store.recordCount) * store.recordSize);
+        std::string strings;
+        std::unordered_map<std::string, uint32> stringOffsets;
+
+        for (uint32 y = 0; y < store.recordCount; ++y)
+        {
+            char* record = &records[y * store.recordSize];
+            for (std::vector<uint32>::const_iterator itr = stringFields.begin(); itr != stringFields.end(); ++itr)
+            {
+                char const* string;
+                memcpy(&string, record + *itr, sizeof(string));
+
+                uintptr_t value = 0;
+                if (string)
+                {
+                    std::pair<std::unordered_map<std::string, uint32>::iterator, bool> res = stringOffsets.insert(std::make_pair(std::string(string), uint32(strings.size())));
+                    if (res.second)
+                        strings.append(string, strlen(string) + 1);
+                    value = res.first->second + 1;
+                }
+
+                memcpy(record + *itr, &value, sizeof(value));
+            }
+        }
+
+        std::vector<uint32> index(store.indexCount, DBC_SNAPSHOT_NO_RECORD);
+        for (uint32 x = 0; x < store.indexCount; ++x)
+            if (char const* entry = store.indexTable[x])
+                index[x] = uint32((entry - store.dataTable) / store.recordSize);
+
+        storeHeader.recordsOffset = sections.size();
+        AppendPadded(sections, records.data(), records.size());
+        storeHeader.indexOffset = sections.size();
+        AppendPadded(sections, index.data(), index.size() * sizeof(uint32));
+        storeHeader.stringsOffset = sections.size();
+        storeHeader.stringSize = strings.size();
+        AppendPadded(sections, strings.data(), strings.size());
+
+        storeHeader.recordsOffset += sectionsOffset;
+        storeHeader.indexOffset += sectionsOffset;
+        storeHeader.stringsOffset += sectionsOffset;
+    }
+
+    header.checksum = HashBytes(0, storeHeaders.data(), storeHeaders.size() * sizeof(DBCSnapshotStoreHeader));
+    header.checksum = HashBytes(header.checksum, sections.data(), sections.size());
+
+    // the old snapshot may still be mapped, it is replaced and not overwritten
+    std::string tmpName = std::string(fileName) + ".tmp";
+    FILE* f = fopen(tmpName.c_str(), "wb");
+    if (!f)
+        return false;
+
+    bool written = fwrite(&header, sizeof(header), 1, f) == 1 &&
+                   (storeHeaders.empty() || fwrite(storeHeaders.data(), storeHeaders.size() * sizeof(DBCSnapshotStoreHeader), 1, f) == 1) &&
+                   (sections.empty() || fwrite(sections.data(), sections.size(), 1, f) == 1);
+
+    if (fclose(f) != 0)
+        written = false;
+
+    if (written && rename(tmpName.c_str(), fileName) != 0)
+    {
+        // not every platform replaces an existing file on rename
+        remove(fileName);
+        written = rename(tmpName.c_str(), fileName) == 0;
+    }
+
+    if (!written)
+        remove(tmpName.c_str());
+
+    return written;
+}
+
+bool DBCSnapshot::AddSourceFile(uint64& signature, char const* fileName)
+{
+    signature = HashBytes(signature, fileName, strlen(fileName));
+
+    struct stat status;
+    if (stat(fileName, &status) != 0)
+        return false;
+
+    uint64 values[2] = { uint64(status.st_size), uint64(status.st_mtime) };
+    signature = HashBytes(signature, values, sizeof(values));
+    return true;
+}
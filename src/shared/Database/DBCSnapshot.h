@@ -0,0 +1,99 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DBC_SNAPSHOT_H
+#define DBC_SNAPSHOT_H
+
+#include "Platform/Define.h"
+#include "MappedFile.h"
+
+#include <string>
+#include <vector>
+
+#define DBC_SNAPSHOT_VERSION        1
+#define DBC_SNAPSHOT_NAME_SIZE      64
+#define DBC_SNAPSHOT_NO_RECORD      0xFFFFFFFF
+
+/**
+ * Binary image of the loaded DBC stores, memory mapped at startup.
+ *
+ * Records are kept as laid out in memory with their string pointers replaced by offsets into
+ * the string table of the store, so a store is restored by one copy of its records and a
+ * pointer fixup instead of parsing its .dbc file and every locale variant of it. The strings
+ * stay in the mapping, which therefore lives as long as the stores.
+ *
+ * The file is rejected as a whole if its version, pointer size or checksum differ. A single
+ * store is rejected if its format, record size or the signature of its source files changed,
+ * it is loaded from the .dbc files then and the snapshot is written anew.
+ */
+class DBCSnapshot
+{
+    public:
+        /// Records and index of one store inside the mapping
+        struct Store
+        {
+            uint32 indexCount;
+            uint32 recordCount;
+            uint8 const* records;
+            uint32 const* index;                            // record number per index, DBC_SNAPSHOT_NO_RECORD if empty
+            char const* strings;
+        };
+
+        DBCSnapshot();
+
+        /// Returns false if the file is missing, of another build or damaged
+        bool Open(char const* fileName);
+        bool IsOpen() const { return m_file.IsOpen(); }
+
+        bool GetStore(char const* name, char const* fmt, uint32 recordSize, uint64 sourceSignature, Store& store) const;
+
+        /// Copies the records of the store and points their strings into the mapping, see DBCFileLoader::AutoProduceData
+        static char* ProduceData(Store const& store, char const* fmt, uint32 recordSize, char**& indexTable);
+
+        /// Remembers a loaded store for Write, its tables must stay unchanged until then
+        void AddStore(char const* name, char const* fmt, uint32 recordSize, uint64 sourceSignature,
+                      uint32 indexCount, char const* const* indexTable, uint32 recordCount, char const* dataTable);
+        void ClearStores() { m_pending.clear(); }
+
+        /// Writes all added stores to a temporary file and replaces the snapshot by it
+        bool Write(char const* fileName) const;
+
+        /// Adds name, size and modification time of a source file to the signature, returns false if it does not exist
+        static bool AddSourceFile(uint64& signature, char const* fileName);
+
+    private:
+        struct PendingStore
+        {
+            std::string name;
+            char const* fmt;
+            uint32 recordSize;
+            uint64 sourceSignature;
+            uint32 indexCount;
+            char const* const* indexTable;
+            uint32 recordCount;
+            char const* dataTable;
+        };
+
+        DBCSnapshot(DBCSnapshot const&);
+        DBCSnapshot& operator=(DBCSnapshot const&);
+
+        MappedFile m_file;
+        std::vector<PendingStore> m_pending;
+};
+
+#endif
@@ -20,13 +20,16 @@
 #define DBCSTORE_H
 
 #include "DBCFileLoader.h"
+#include "DBCSnapshot.h"
+
+#include <cstring>
 
 template<class T>
 class DBCStorage
 {
         typedef std::list<char*> StringPoolList;
     public:
-        explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(nullptr), m_dataTable(nullptr) { }
+        explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(nullptr), m_dataTable(nullptr), m_recordCount(0) { }
         ~DBCStorage() { Clear(); }
 
         T const* LookupEntry(uint32 id) const { return (id >= nCount) ? nullptr : indexTable[id]; }
@@ -42,6 +45,7 @@ class DBCStorage
                 return false;
 
             fieldCount = dbc.GetCols();
+            m_recordCount = dbc.GetNumRows();
 
             // load raw non-string data
             m_dataTable = (T*)dbc.AutoProduceData(fmt, nCount, (char**&)indexTable);
@@ -70,6 +74,26 @@ class DBCStorage
             return true;
         }
 
+        bool LoadFromSnapshot(DBCSnapshot const& snapshot, char const* name, uint64 sourceSignature)
+        {
+            DBCSnapshot::Store store;
+            if (!snapshot.GetStore(name, fmt, sizeof(T), sourceSignature, store))
+                return false;
+
+            fieldCount = strlen(fmt);
+            m_recordCount = store.recordCount;
+
+            // records with localized strings of all locales, the strings stay in the snapshot
+            m_dataTable = (T*)DBCSnapshot::ProduceData(store, fmt, sizeof(T), (char**&)indexTable);
+            nCount = store.indexCount;
+            return true;
+        }
+
+        void AddToSnapshot(DBCSnapshot& snapshot, char const* name, uint64 sourceSignature) const
+        {
+            snapshot.AddStore(name, fmt, sizeof(T), sourceSignature, nCount, (char const* const*)indexTable, m_recordCount, (char const*)m_dataTable);
+        }
+
         void Clear()
         {
             if (!indexTable)
@@ -86,6 +110,7 @@ class DBCStorage
                 m_stringPoolList.pop_front();
             }
             nCount = 0;
+            m_recordCount = 0;
         }
 
         void EraseEntry(uint32 id) { assert(id < nCount && "To be erased entry must be in bounds!") ; indexTable[id] = nullptr; }
@@ -97,6 +122,7 @@ class DBCStorage
         char const* fmt;
         T** indexTable;
         T* m_dataTable;
+        uint32 m_recordCount;                               // in m_dataTable, the index may have gaps
         StringPoolList m_stringPoolList;
 };
 
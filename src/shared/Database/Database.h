@@ -48,6 +48,8 @@ class SqlConnection
         // public methods for making queries
         virtual QueryResult* Query(const char* sql) = 0;
         virtual QueryNamedResult* QueryNamed(const char* sql) = 0;
+        // rows are fetched while they are read, falls back to Query if the DB has no such mode
+        virtual QueryResult* QueryUnbuffered(const char* sql) { return Query(sql); }
 
         // public methods for making requests
         virtual bool Execute(const char* sql) = 0;
@@ -123,6 +125,14 @@ class Database
             return guard->QueryNamed(sql);
         }
 
+        // for large results read once, like the SQLStorage tables at startup
+        // the rows stay on the server until fetched, so the calling thread must not use this database until the result is deleted
+        inline QueryResult* QueryUnbuffered(const char* sql)
+        {
+            SqlConnection::Lock guard(getQueryConnection());
+            return guard->QueryUnbuffered(sql);
+        }
+
         QueryResult* PQuery(const char* format, ...) ATTR_PRINTF(2, 3);
         QueryNamedResult* PQueryNamed(const char* format, ...) ATTR_PRINTF(2, 3);
 
@@ -225,6 +225,72 @@ QueryResult* MySQLConnection::Query(const char* sql)
     return queryResult;
 }
 
+// rows of mysql_use_result are read from the socket, nothing else may run on the connection until they are all read or dropped
+class QueryResultMysqlUnbuffered : public QueryResultMysql
+{
+    public:
+        QueryResultMysqlUnbuffered(SqlConnection* conn, MYSQL* mysql, MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount) :
+            QueryResultMysql(result, fields, 0, fieldCount), m_guard(conn), m_mysql(mysql), m_failed(false) {}
+
+        ~QueryResultMysqlUnbuffered() { EndQuery(); }       // before the connection is unlocked
+
+        bool NextRow() override
+        {
+            if (QueryResultMysql::NextRow())
+                return true;
+
+            // a lost connection ends the rows as well
+            if (mysql_errno(m_mysql))
+            {
+                sLog.outErrorDb("query ERROR: %s", mysql_error(m_mysql));
+                m_failed = true;
+            }
+
+            return false;
+        }
+
+        bool Failed() const override { return m_failed; }
+
+    private:
+        SqlConnection::Lock m_guard;
+        MYSQL* m_mysql;
+        bool m_failed;
+};
+
+QueryResult* MySQLConnection::QueryUnbuffered(const char* sql)
+{
+    if (!mMysql)
+        return nullptr;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    if (mysql_query(mMysql, sql))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_error(mMysql));
+        return nullptr;
+    }
+    else
+    {
+        DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+    }
+
+    MYSQL_RES* result = mysql_use_result(mMysql);
+    if (!result)
+        return nullptr;
+
+    // the row count is not known before all rows are read
+    QueryResultMysql* queryResult = new QueryResultMysqlUnbuffered(this, mMysql, result, mysql_fetch_fields(result), mysql_field_count(mMysql));
+
+    if (!queryResult->NextRow())
+    {
+        delete queryResult;
+        return nullptr;
+    }
+
+    return queryResult;
+}
+
 QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
 {
     MYSQL_RES* result = nullptr;
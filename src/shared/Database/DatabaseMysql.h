@@ -75,6 +75,7 @@ class MySQLConnection : public SqlConnection
 
         QueryResult* Query(const char* sql) override;
         QueryNamedResult* QueryNamed(const char* sql) override;
+        QueryResult* QueryUnbuffered(const char* sql) override;
         bool Execute(const char* sql) override;
 
         unsigned long escape_string(char* to, const char* from, unsigned long length);
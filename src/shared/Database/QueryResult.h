@@ -32,6 +32,8 @@ class QueryResult
         virtual ~QueryResult() {}
 
         virtual bool NextRow() = 0;
+        // the rows ended by an error instead of the end of the result (unbuffered results only)
+        virtual bool Failed() const { return false; }
 
         Field* Fetch() const { return mCurrentRow; }
 
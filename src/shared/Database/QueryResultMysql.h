@@ -39,9 +39,11 @@ class QueryResultMysql : public QueryResult
 
         bool NextRow() override;
 
+    protected:
+        void EndQuery();
+
     private:
         enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
-        void EndQuery();
 
         MYSQL_RES* mResult;
 };
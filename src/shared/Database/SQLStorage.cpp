@@ -30,7 +30,9 @@ SQLStorageBase::SQLStorageBase() :
     m_recordCount(0),
     m_maxEntry(0),
     m_recordSize(0),
-    m_data(nullptr)
+    m_recordCapacity(0),
+    m_data(nullptr),
+    m_stringBlockUsed(0)
 {}
 
 void SQLStorageBase::Initialize(const char* tableName, const char* entry_field, const char* src_format, const char* dst_format)
@@ -46,23 +48,94 @@ void SQLStorageBase::Initialize(const char* tableName, const char* entry_field,
 
 char* SQLStorageBase::createRecord(uint32 recordId)
 {
+    if (m_recordCount == m_recordCapacity)
+    {
+        uint32 capacity = m_recordCapacity ? m_recordCapacity * 2 : SQL_STORAGE_MIN_CAPACITY;
+
+        char* data = new char[capacity * m_recordSize];
+        if (m_data)
+            memcpy(data, m_data, m_recordCount * m_recordSize);
+        memset(data + m_recordCount * m_recordSize, 0, (capacity - m_recordCount) * m_recordSize);
+
+        delete[] m_data;
+        m_data = data;
+        m_recordCapacity = capacity;
+    }
+
     char* newRecord = &m_data[m_recordCount * m_recordSize];
     ++m_recordCount;
 
-    JustCreatedRecord(recordId, newRecord);
+    m_recordIds.push_back(recordId);
+    if (recordId >= m_maxEntry)
+        m_maxEntry = recordId + 1;
+
     return newRecord;
 }
 
-void SQLStorageBase::prepareToLoad(uint32 maxEntry, uint32 recordCount, uint32 recordSize)
+char* SQLStorageBase::createString(char const* src)
 {
-    m_maxEntry = maxEntry;
+    if (!src)
+        src = "";
+
+    StringSet::const_iterator itr = m_strings.find(src);
+    if (itr != m_strings.end())
+        return const_cast<char*>(*itr);
+
+    uint32 size = strlen(src) + 1;
+    if (m_stringBlocks.empty() || m_stringBlockUsed + size > m_stringBlocks.back().second)
+    {
+        uint32 blockSize = std::max(size, uint32(SQL_STORAGE_STRING_BLOCK));
+        m_stringBlocks.push_back(StringBlock(new char[blockSize], blockSize));
+        m_stringBlockUsed = 0;
+    }
+
+    char* dst = m_stringBlocks.back().first + m_stringBlockUsed;
+    memcpy(dst, src, size);
+    m_stringBlockUsed += size;
+
+    m_strings.insert(dst);
+    return dst;
+}
+
+bool SQLStorageBase::IsArenaString(char const* str) const
+{
+    std::less<char const*> less;
+    for (std::vector<StringBlock>::const_iterator itr = m_stringBlocks.begin(); itr != m_stringBlocks.end(); ++itr)
+        if (!less(str, itr->first) && less(str, itr->first + itr->second))
+            return true;
+
+    return false;
+}
+
+void SQLStorageBase::prepareToLoad(uint32 recordSize)
+{
+    // Clear (possible) old data and old index
+    Free();
+
     m_recordSize = recordSize;
+    m_recordCapacity = 0;
+    m_maxEntry = 0;
+}
 
-    delete[] m_data;
-    m_data = new char[recordCount * m_recordSize];
-    memset(m_data, 0, recordCount * m_recordSize);
+void SQLStorageBase::finishLoad()
+{
+    // give back what the last growth did not use, the iterators only need the records
+    if (m_recordCount < m_recordCapacity)
+    {
+        char* data = new char[m_recordCount * m_recordSize];
+        memcpy(data, m_data, m_recordCount * m_recordSize);
 
-    m_recordCount = 0;
+        delete[] m_data;
+        m_data = data;
+        m_recordCapacity = m_recordCount;
+    }
+
+    prepareIndex(m_maxEntry);
+    for (uint32 i = 0; i < m_recordCount; ++i)
+        JustCreatedRecord(m_recordIds[i], &m_data[i * m_recordSize]);
+
+    std::vector<uint32>().swap(m_recordIds);
+    StringSet().swap(m_strings);
 }
 
 // Function to delete the data
@@ -81,8 +154,13 @@ void SQLStorageBase::Free()
                 break;
             case FT_STRING:
             {
+                // strings of the table are freed with its arena, only those replaced after loading are owned by the record
                 for (uint32 recordItr = 0; recordItr < m_recordCount; ++recordItr)
-                    delete[] *(char**)((char*)(m_data + (recordItr * m_recordSize)) + offset);
+                {
+                    char* str = *(char**)((char*)(m_data + (recordItr * m_recordSize)) + offset);
+                    if (str && !IsArenaString(str))
+                        delete[] str;
+                }
 
                 offset += sizeof(char*);
                 break;
@@ -118,6 +196,15 @@ void SQLStorageBase::Free()
     delete[] m_data;
     m_data = nullptr;
     m_recordCount = 0;
+    m_recordCapacity = 0;
+
+    for (std::vector<StringBlock>::const_iterator itr = m_stringBlocks.begin(); itr != m_stringBlocks.end(); ++itr)
+        delete[] itr->first;
+    m_stringBlocks.clear();
+    m_stringBlockUsed = 0;
+
+    m_recordIds.clear();
+    m_strings.clear();
 }
 
 // -----------------------------------  SQLStorage  -------------------------------------------- //
@@ -152,16 +239,11 @@ SQLStorage::SQLStorage(const char* src_fmt, const char* dst_fmt, const char* _en
     m_Index = nullptr;
 }
 
-void SQLStorage::prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize)
+void SQLStorage::prepareIndex(uint32 maxRecordId)
 {
-    // Clear (possible) old data and old index array
-    Free();
-
     // Set index array
     m_Index = new char* [maxRecordId];
     memset(m_Index, 0, maxRecordId * sizeof(char*));
-
-    SQLStorageBase::prepareToLoad(maxRecordId, recordCount, recordSize);
 }
 
 // -----------------------------------  SQLHashStorage  ---------------------------------------- //
@@ -177,12 +259,9 @@ void SQLHashStorage::Free()
     m_indexMap.clear();
 }
 
-void SQLHashStorage::prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize)
+void SQLHashStorage::prepareIndex(uint32 /*maxRecordId*/)
 {
-    // Clear (possible) old data and old index array
-    Free();
-
-    SQLStorageBase::prepareToLoad(maxRecordId, recordCount, recordSize);
+    m_indexMap.reserve(GetRecordCount());
 }
 
 void SQLHashStorage::EraseEntry(uint32 id)
@@ -216,14 +295,6 @@ void SQLMultiStorage::Free()
     m_indexMultiMap.clear();
 }
 
-void SQLMultiStorage::prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize)
-{
-    // Clear (possible) old data and old index array
-    Free();
-
-    SQLStorageBase::prepareToLoad(maxRecordId, recordCount, recordSize);
-}
-
 void SQLMultiStorage::EraseEntry(uint32 id)
 {
     m_indexMultiMap.erase(id);
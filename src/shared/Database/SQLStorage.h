@@ -23,6 +23,11 @@
 #include "Database/DatabaseEnv.h"
 #include "DBCFileLoader.h"
 
+#include <unordered_set>
+
+#define SQL_STORAGE_MIN_CAPACITY    256                     // records allocated by the first createRecord
+#define SQL_STORAGE_STRING_BLOCK    (64 * 1024)
+
 class SQLStorageBase
 {
         template<class DerivedLoader, class StorageClass> friend class SQLStorageLoaderBase;
@@ -74,12 +79,38 @@ class SQLStorageBase
         uint32 GetSrcFieldCount() const { return m_srcFieldCount; }
         uint32 GetRecordSize() const { return m_recordSize; }
 
-        virtual void prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize);
+        void prepareToLoad(uint32 recordSize);
+        virtual void prepareIndex(uint32 /*maxRecordId*/) {}
         virtual void JustCreatedRecord(uint32 recordId, char* record) = 0;
         virtual void Free();
 
     private:
+        // records are stored in load order and only indexed once all are read, the data grows while loading
         char* createRecord(uint32 recordId);
+        void finishLoad();
+
+        // equal strings of a table share one copy in its string arena
+        char* createString(char const* src);
+        bool IsArenaString(char const* str) const;
+
+        struct CStringHash
+        {
+            size_t operator()(char const* str) const
+            {
+                size_t hash = 0;
+                for (; *str; ++str)
+                    hash = hash * 31 + uint8(*str);
+                return hash;
+            }
+        };
+
+        struct CStringEqual
+        {
+            bool operator()(char const* left, char const* right) const { return strcmp(left, right) == 0; }
+        };
+
+        typedef std::unordered_set<char const*, CStringHash, CStringEqual> StringSet;
+        typedef std::pair<char*, uint32> StringBlock;        // memory, size
 
         // Information about the table
         const char* m_tableName;
@@ -93,9 +124,18 @@ class SQLStorageBase
         uint32 m_recordCount;
         uint32 m_maxEntry;
         uint32 m_recordSize;
+        uint32 m_recordCapacity;
 
         // Data Storage
         char* m_data;
+
+        // String Storage
+        std::vector<StringBlock> m_stringBlocks;
+        uint32 m_stringBlockUsed;                           // of the last block
+
+        // Only while loading
+        std::vector<uint32> m_recordIds;
+        StringSet m_strings;
 };
 
 class SQLStorage : public SQLStorageBase
@@ -122,7 +162,7 @@ class SQLStorage : public SQLStorageBase
         void EraseEntry(uint32 id);
 
     protected:
-        void prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize) override;
+        void prepareIndex(uint32 maxRecordId) override;
         void JustCreatedRecord(uint32 recordId, char* record) override
         {
             m_Index[recordId] = record;
@@ -159,7 +199,7 @@ class SQLHashStorage : public SQLStorageBase
         void EraseEntry(uint32 id);
 
     protected:
-        void prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize) override;
+        void prepareIndex(uint32 maxRecordId) override;
         void JustCreatedRecord(uint32 recordId, char* record) override
         {
             m_indexMap[recordId] = record;
@@ -232,7 +272,6 @@ class SQLMultiStorage : public SQLStorageBase
         void EraseEntry(uint32 id);
 
     protected:
-        void prepareToLoad(uint32 maxRecordId, uint32 recordCount, uint32 recordSize) override;
         void JustCreatedRecord(uint32 recordId, char* record) override
         {
             m_indexMultiMap.insert(RecordMultiMap::value_type(recordId, record));
@@ -269,6 +308,9 @@ class SQLStorageLoaderBase
         void convert_from_str(uint32 field_pos, char* src, D& dst);
         void convert_str_to_str(uint32 field_pos, char* src, char*& dst);
 
+    protected:
+        StorageClass* m_store;                              // while loading, the default string conversions copy into its arena
+
     private:
         template<class V>
         void storeValue(V value, StorageClass& store, char* record, uint32 field_pos, uint32& offset);
@@ -21,6 +21,7 @@
 
 #include "ProgressBar.h"
 #include "Log.h"
+#include "Timer.h"
 #include "DBCFileLoader.h"
 
 template<class DerivedLoader, class StorageClass>
@@ -41,25 +42,14 @@ template<class DerivedLoader, class StorageClass>
 
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::convert_str_to_str(uint32 /*field_pos*/, char const* src, char*& dst)
 {
-    if (!src)
-    {
-        dst = new char[1];
-        *dst = 0;
-    }
-    else
-    {
-        uint32 l = strlen(src) + 1;
-        dst = new char[l];
-        memcpy(dst, src, l);
-    }
+    dst = m_store->createString(src);
 }
 
 template<class DerivedLoader, class StorageClass>
 template<class S>                                           // S source-type
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::convert_to_str(uint32 /*field_pos*/, S /*src*/, char*& dst)
 {
-    dst = new char[1];
-    *dst = 0;
+    dst = m_store->createString(nullptr);
 }
 
 template<class DerivedLoader, class StorageClass>
@@ -85,8 +75,7 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::default_fill(uint32 /*fi
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::default_fill_to_str(uint32 /*field_pos*/, char const* /*src*/, char*& dst)
 {
-    dst = new char[1];
-    *dst = 0;
+    dst = m_store->createString(nullptr);
 }
 
 template<class DerivedLoader, class StorageClass>
@@ -189,44 +178,34 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
-    Field* fields = nullptr;
-    QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
-    if (!result)
-    {
-        sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
-        Log::WaitBeforeContinueIfNeed();
-        exit(1);                                            // Stop server at loading non exited table or not accessable table
-    }
-
-    uint32 maxRecordId = (*result)[0].GetUInt32() + 1;
-    uint32 recordCount = 0;
+    uint32 startTime = WorldTimer::getMSTime();
     uint32 recordsize = 0;
-    delete result;
-
-    result = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
-    if (result)
-    {
-        fields = result->Fetch();
-        recordCount = fields[0].GetUInt32();
-        delete result;
-    }
 
-    result = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+    // the rows are converted while they arrive, neither the record count nor the highest entry are asked for before
+    QueryResult* result = WorldDatabase.QueryUnbuffered((std::string("SELECT * FROM ") + store.GetTableName()).c_str());
 
     if (!result)
     {
+        // an empty table still answers a count, a missing one does not
+        if (QueryResult* countResult = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName()))
+            delete countResult;
+        else
+        {
+            sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
+            Log::WaitBeforeContinueIfNeed();
+            exit(1);                                        // Stop server at loading non exited table or not accessable table
+        }
+
         if (error_at_empty)
             sLog.outError("%s table is empty!\n", store.GetTableName());
         else
             sLog.outString("%s table is empty!\n", store.GetTableName());
 
-        recordCount = 0;
         return;
     }
 
     if (store.GetSrcFieldCount() != result->GetFieldCount())
     {
-        recordCount = 0;
         sLog.outError("Error in %s table, probably sql file format was updated (there should be %d fields in sql).\n", store.GetTableName(), store.GetSrcFieldCount());
         delete result;
         Log::WaitBeforeContinueIfNeed();
@@ -234,7 +213,6 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     }
 
     // get struct size
-    uint32 offset = 0;
     for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
     {
         switch (store.GetDstFormat(x))
@@ -269,17 +247,16 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         }
     }
 
-    // Prepare data storage and lookup storage
-    store.prepareToLoad(maxRecordId, recordCount, recordsize);
+    // Prepare data storage, the lookup storage is built once all records are read
+    store.prepareToLoad(recordsize);
+    m_store = &store;
 
-    BarGoLink bar(recordCount);
     do
     {
-        fields = result->Fetch();
-        bar.step();
+        Field* fields = result->Fetch();
 
         char* record = store.createRecord(fields[0].GetUInt32());
-        offset = 0;
+        uint32 offset = 0;
 
         // dependend on dest-size
         // iterate two indexes: x over dest, y over source
@@ -328,7 +305,20 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     }
     while (result->NextRow());
 
+    bool failed = result->Failed();
     delete result;
+
+    if (failed)
+    {
+        sLog.outError("Error loading %s table, reading its rows failed after %u records.\n", store.GetTableName(), store.GetRecordCount());
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);                                            // Stop server instead of running with a truncated table
+    }
+
+    store.finishLoad();
+    m_store = nullptr;
+
+    sLog.outString(">> Read %u records of `%s` in %u ms", store.GetRecordCount(), store.GetTableName(), WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
 }
 
 #endif
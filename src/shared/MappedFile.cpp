@@ -0,0 +1,105 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MappedFile.h"
+
+#if PLATFORM == PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(char const* fileName)
+{
+    Close();
+
+#if PLATFORM == PLATFORM_WINDOWS
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || !size.QuadPart)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    // the view keeps the mapping alive
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+        return false;
+
+    m_size = size_t(size.QuadPart);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || !status.st_size)
+    {
+        close(fd);
+        return false;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    void* data = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    m_size = size_t(status.st_size);
+#endif
+
+    m_data = static_cast<uint8 const*>(data);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (!m_data)
+        return;
+
+#if PLATFORM == PLATFORM_WINDOWS
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<uint8*>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
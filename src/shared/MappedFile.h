@@ -0,0 +1,55 @@
+/*
+ * This file is part of the Firestorm Freelance Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOSSERVER_MAPPEDFILE_H
+#define MANGOSSERVER_MAPPEDFILE_H
+
+#include "Platform/Define.h"
+
+#include <cstddef>
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * The pages are loaded on first access and shared with every other mapping of the
+ * same file through the page cache. The mapping starts at a page boundary.
+ */
+class MappedFile
+{
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        /// Returns false if the file does not exist or can't be mapped
+        bool Open(char const* fileName);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+
+        uint8 const* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+    private:
+        MappedFile(MappedFile const&);
+        MappedFile& operator=(MappedFile const&);
+
+        uint8 const* m_data;
+        size_t m_size;
+};
+
+#endif